@@ -47,9 +47,9 @@ bool active_item_cache::empty() const
 // It relies on the processing logic to remove and reinsert the items to they
 // move to the back of their respective lists (or to new lists).
 // Otherwise only the first n items will ever be processed.
-std::list<item_reference> active_item_cache::get()
+scratch_vector<item_reference> active_item_cache::get()
 {
-    std::list<item_reference> items_to_process;
+    scratch_vector<item_reference> items_to_process;
     for( auto &tuple : active_items ) {
         // Rely on iteration logic to make sure the number is sane.
         int num_to_process = tuple.second.size() / tuple.first;
@@ -3,6 +3,7 @@
 
 #include "enums.h"
 #include "item.h"
+#include "scratch_arena.h"
 #include <list>
 #include <unordered_map>
 #include <unordered_set>
@@ -29,7 +30,7 @@ class active_item_cache
         // Use this one if there's a chance that the item being referenced has been invalidated.
         bool has( item_reference const &itm ) const;
         bool empty() const;
-        std::list<item_reference> get();
+        scratch_vector<item_reference> get();
 };
 
 #endif
@@ -337,6 +337,7 @@ std::list<item> obtain_activity_items( player_activity &act, player &p )
     if( excessive_volume > 0 ) {
         const auto excess = p.inv.remove_randomly_by_volume( excessive_volume );
         res.insert( res.begin(), excess.begin(), excess.end() );
+        p.invalidate_artifact_cache();
     }
     // Load anything that remains (if any) into the activity
     act.values.clear();
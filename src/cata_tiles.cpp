@@ -29,6 +29,7 @@
 #include "submap.h"
 #include "overlay_ordering.h"
 #include "cata_utility.h"
+#include "memory_usage.h"
 
 #include <algorithm>
 #include <fstream>
@@ -162,6 +163,7 @@ void cata_tiles::init()
     }
 
     // Try to load tileset
+    memory_usage::tag_scope tag( memory_usage::tag::tiles );
     load_tilejson(config_path, json_path, tileset_path);
 }
 
@@ -179,6 +181,14 @@ void cata_tiles::reinit_minimap()
     minimap_reinit_flag = true;
 }
 
+size_t cata_tiles::estimate_memory_usage() const
+{
+    // Textures live in video memory, count 4 bytes per pixel for each tile and variant.
+    const size_t tiles = tile_values.size() + shadow_tile_values.size() +
+                         night_tile_values.size() + overexposed_tile_values.size();
+    return tiles * tile_width * tile_height * 4 + tile_ids.size() * sizeof( tile_type );
+}
+
 void cata_tiles::get_tile_information(std::string config_path, std::string &json_path, std::string &tileset_path)
 {
     const std::string default_json = FILENAMES["defaulttilejson"];
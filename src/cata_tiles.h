@@ -442,6 +442,9 @@ class cata_tiles
 
         void reinit_minimap();
 
+        /** Approximate texture memory of the loaded tileset (all tile variants). */
+        size_t estimate_memory_usage() const;
+
         int get_tile_height() const {
             return tile_height;
         }
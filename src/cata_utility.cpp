@@ -12,6 +12,8 @@
 #include "json.h"
 #include "filesystem.h"
 #include "item_search.h"
+#include "compression.h"
+#include "catacharset.h"
 
 #include <algorithm>
 #include <cmath>
@@ -29,15 +31,17 @@ bool isBetween( int test, int down, int up )
 
 bool lcmatch( const std::string &str, const std::string &qry )
 {
-    std::string needle;
-    needle.reserve( qry.size() );
-    std::transform( qry.begin(), qry.end(), std::back_inserter( needle ), tolower );
-
-    std::string haystack;
-    haystack.reserve( str.size() );
-    std::transform( str.begin(), str.end(), std::back_inserter( haystack ), tolower );
+    // Reused, so searching doesn't allocate once they are large enough.
+    static thread_local std::string needle;
+    fold_case( qry, needle );
+    return lcmatch_folded( str, needle );
+}
 
-    return haystack.find( needle ) != std::string::npos;
+bool lcmatch_folded( const std::string &str, const std::string &folded_qry )
+{
+    static thread_local std::string haystack;
+    fold_case( str, haystack );
+    return haystack.find( folded_qry ) != std::string::npos;
 }
 
 std::vector<map_item_stack> filter_item_stacks( std::vector<map_item_stack> stack,
@@ -348,7 +352,8 @@ float multi_lerp( const std::vector<std::pair<float, float>> &points, float x )
     return ( t * points[i].second ) + ( ( 1 - t ) * points[i - 1].second );
 }
 
-ofstream_wrapper::ofstream_wrapper( const std::string &path )
+ofstream_wrapper::ofstream_wrapper( const std::string &path, const bool compressed )
+    : compressed( compressed )
 {
     file_stream.open( path.c_str(), std::ios::binary );
     if( !file_stream.is_open() ) {
@@ -360,6 +365,9 @@ ofstream_wrapper::~ofstream_wrapper() = default;
 
 void ofstream_wrapper::close()
 {
+    if( compressed ) {
+        file_stream << compression::pack( buffer.str() );
+    }
     file_stream.close();
     if( file_stream.fail() ) {
         throw std::runtime_error( "writing to file failed" );
@@ -367,10 +375,10 @@ void ofstream_wrapper::close()
 }
 
 bool write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
-                    const char *const fail_message )
+                    const char *const fail_message, const bool compressed )
 {
     try {
-        ofstream_wrapper fout( path );
+        ofstream_wrapper fout( path, compressed );
         writer( fout.stream() );
         fout.close();
         return true;
@@ -383,8 +391,9 @@ bool write_to_file( const std::string &path, const std::function<void( std::ostr
     }
 }
 
-ofstream_wrapper_exclusive::ofstream_wrapper_exclusive( const std::string &path )
-    : path( path )
+ofstream_wrapper_exclusive::ofstream_wrapper_exclusive( const std::string &path,
+        const bool compressed )
+    : path( path ), compressed( compressed )
 {
     fopen_exclusive( file_stream, path.c_str(), std::ios::binary );
     if( !file_stream.is_open() ) {
@@ -401,6 +410,9 @@ ofstream_wrapper_exclusive::~ofstream_wrapper_exclusive()
 
 void ofstream_wrapper_exclusive::close()
 {
+    if( compressed ) {
+        file_stream << compression::pack( buffer.str() );
+    }
     fclose_exclusive( file_stream, path.c_str() );
     if( file_stream.fail() ) {
         throw std::runtime_error( _( "writing to file failed" ) );
@@ -408,10 +420,11 @@ void ofstream_wrapper_exclusive::close()
 }
 
 bool write_to_file_exclusive( const std::string &path,
-                              const std::function<void( std::ostream & )> &writer, const char *const fail_message )
+                              const std::function<void( std::ostream & )> &writer, const char *const fail_message,
+                              const bool compressed )
 {
     try {
-        ofstream_wrapper_exclusive fout( path );
+        ofstream_wrapper_exclusive fout( path, compressed );
         writer( fout.stream() );
         fout.close();
         return true;
@@ -431,6 +444,16 @@ bool read_from_file( const std::string &path, const std::function<void( std::ist
         if( !fin ) {
             throw std::runtime_error( "opening file failed" );
         }
+        if( compression::is_packed( fin ) ) {
+            std::ostringstream packed;
+            packed << fin.rdbuf();
+            if( fin.bad() ) {
+                throw std::runtime_error( "reading file failed" );
+            }
+            std::istringstream content( compression::unpack( packed.str() ) );
+            reader( content );
+            return true;
+        }
         reader( fin );
         if( fin.bad() ) {
             throw std::runtime_error( "reading file failed" );
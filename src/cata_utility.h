@@ -6,6 +6,7 @@
 #include <vector>
 #include <fstream>
 #include <functional>
+#include <sstream>
 
 class item;
 class Creature;
@@ -32,6 +33,8 @@ bool isBetween( int test, int down, int up );
 
 /** Does str contain qry via case-insensitive comparison? */
 bool lcmatch( const std::string &str, const std::string &qry );
+/** Like @ref lcmatch, but the query was already passed through @ref fold_case. */
+bool lcmatch_folded( const std::string &str, const std::string &folded_qry );
 
 std::vector<map_item_stack> filter_item_stacks( std::vector<map_item_stack> stack,
         std::string filter );
@@ -136,21 +139,27 @@ class list_circularizer
  * to it.
  * Note: the stream is closed in the constructor, but no exception is throw from it. To
  * ensure all errors get reported correctly, you should always call `close` explicitly.
+ *
+ * If \p compressed is true, the output is collected in memory and written compressed
+ * (see @ref compression::pack) by @ref close, nothing is written without calling it.
+ * @ref read_from_file reads both kinds of files.
  */
 class ofstream_wrapper
 {
     private:
         std::ofstream file_stream;
+        bool compressed;
+        std::ostringstream buffer;
 
     public:
-        ofstream_wrapper( const std::string &path );
+        ofstream_wrapper( const std::string &path, bool compressed = false );
         ~ofstream_wrapper();
 
         std::ostream &stream() {
-            return file_stream;
+            return compressed ? static_cast<std::ostream &>( buffer ) : file_stream;
         }
         operator std::ostream &() {
-            return file_stream;
+            return stream();
         }
 
         void close();
@@ -160,10 +169,11 @@ class ofstream_wrapper
  * Open a file for writing, calls the writer on that stream. If the writer throws, or if the file
  * could not be opened or if any I/O error happens, the function shows a popup containing the
  * \p fail_message, the error text and the path.
+ * @param compressed Whether to write the file compressed, see @ref ofstream_wrapper.
  * @return Whether saving succeeded (no error was caught).
  */
 bool write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
-                    const char *fail_message );
+                    const char *fail_message, bool compressed = false );
 class JsonIn;
 class JsonDeserializer;
 /**
@@ -182,6 +192,9 @@ class JsonDeserializer;
  * exist. They simply ignore the call and return `false` immediately (without calling the callback).
  * They can be used for loading legacy files.
  *
+ * Compressed files (see @ref ofstream_wrapper) are recognized by their header and are
+ * decompressed before the callback sees them.
+ *
  * @return `true` is the file was read without any errors, `false` upon any error.
  */
 /**@{*/
@@ -205,16 +218,18 @@ class ofstream_wrapper_exclusive
     private:
         std::ofstream file_stream;
         std::string path;
+        bool compressed;
+        std::ostringstream buffer;
 
     public:
-        ofstream_wrapper_exclusive( const std::string &path );
+        ofstream_wrapper_exclusive( const std::string &path, bool compressed = false );
         ~ofstream_wrapper_exclusive();
 
         std::ostream &stream() {
-            return file_stream;
+            return compressed ? static_cast<std::ostream &>( buffer ) : file_stream;
         }
         operator std::ostream &() {
-            return file_stream;
+            return stream();
         }
 
         void close();
@@ -222,6 +237,7 @@ class ofstream_wrapper_exclusive
 
 /** See @ref write_to_file, but uses the exclusive I/O functions. */
 bool write_to_file_exclusive( const std::string &path,
-                              const std::function<void( std::ostream & )> &writer,  const char *fail_message );
+                              const std::function<void( std::ostream & )> &writer,  const char *fail_message,
+                              bool compressed = false );
 
 #endif // CAT_UTILITY_H
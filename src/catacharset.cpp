@@ -124,6 +124,80 @@ std::string utf32_to_utf8(uint32_t ch)
     return out;
 }
 
+uint32_t fold_case( const uint32_t ch )
+{
+    if( ch < 0x80 ) {
+        return ch >= 'A' && ch <= 'Z' ? ch + ( 'a' - 'A' ) : ch;
+    }
+    // Latin-1 Supplement, except the multiplication sign
+    if( ch >= 0xC0 && ch <= 0xDE && ch != 0xD7 ) {
+        return ch + 0x20;
+    }
+    // Latin Extended-A has upper and lower case letters next to each other
+    if( ch == 0x130 ) {
+        return 'i';
+    }
+    if( ( ch >= 0x100 && ch <= 0x137 ) || ( ch >= 0x14A && ch <= 0x177 ) ) {
+        return ch | 1;
+    }
+    if( ( ch >= 0x139 && ch <= 0x148 ) || ( ch >= 0x179 && ch <= 0x17E ) ) {
+        return ch % 2 == 1 ? ch + 1 : ch;
+    }
+    if( ch == 0x178 ) {
+        return 0xFF;
+    }
+    // Greek
+    if( ch >= 0x391 && ch <= 0x3A9 && ch != 0x3A2 ) {
+        return ch + 0x20;
+    }
+    if( ch == 0x386 ) {
+        return 0x3AC;
+    }
+    if( ch >= 0x388 && ch <= 0x38A ) {
+        return ch + 0x25;
+    }
+    if( ch == 0x38C ) {
+        return 0x3CC;
+    }
+    if( ch == 0x38E || ch == 0x38F ) {
+        return ch + 0x3F;
+    }
+    // Cyrillic
+    if( ch >= 0x400 && ch <= 0x40F ) {
+        return ch + 0x50;
+    }
+    if( ch >= 0x410 && ch <= 0x42F ) {
+        return ch + 0x20;
+    }
+    return ch;
+}
+
+void fold_case( const std::string &str, std::string &out )
+{
+    out.clear();
+    out.reserve( str.size() );
+    const char *p = str.c_str();
+    int len = str.size();
+    while( len > 0 ) {
+        const char *const start = p;
+        const uint32_t ch = UTF8_getch( &p, &len );
+        const uint32_t folded = fold_case( ch );
+        if( folded == ch ) {
+            out.append( start, p );
+        } else {
+            // Short enough for the small string optimization, nothing is allocated.
+            out += utf32_to_utf8( folded );
+        }
+    }
+}
+
+std::string fold_case( const std::string &str )
+{
+    std::string result;
+    fold_case( str, result );
+    return result;
+}
+
 //Calculate width of a unicode string
 //Latin characters have a width of 1
 //CJK characters have a width of 2, etc
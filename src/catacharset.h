@@ -34,6 +34,15 @@ std::string utf8_substr( std::string s, int start, int size = -1 );
 std::string utf32_to_utf8( uint32_t ch );
 std::string utf8_truncate( std::string s, size_t length );
 
+/** Lower case version of a code point. Knows the Latin, Greek and Cyrillic letters. */
+uint32_t fold_case( uint32_t ch );
+/**
+ * Lower case version of str for case insensitive searches, written to out (reusing its
+ * memory). Everything without a lower case version, even invalid UTF-8, stays as it is.
+ */
+void fold_case( const std::string &str, std::string &out );
+std::string fold_case( const std::string &str );
+
 std::string base64_encode( std::string str );
 std::string base64_decode( std::string str );
 
@@ -18,6 +18,7 @@
 #include "vehicle.h"
 #include "veh_interact.h"
 #include "cata_utility.h"
+#include "itype.h"
 
 #include <algorithm>
 
@@ -334,6 +335,8 @@ void Character::process_turn()
 {
     Creature::process_turn();
     drop_inventory_overflow();
+    // Some code still modifies weapon/worn/inv directly, rebuild at least once per turn.
+    invalidate_artifact_cache();
 }
 
 void Character::recalc_hp()
@@ -590,6 +593,7 @@ item& Character::i_add(item it)
 
     auto &item_in_inv = inv.add_item(it, keep_invlet);
     item_in_inv.on_pickup( *this );
+    invalidate_artifact_cache();
     return item_in_inv;
 }
 
@@ -650,6 +654,7 @@ int Character::get_item_position( const item *it ) const
 item Character::i_rem(int pos)
 {
  item tmp;
+ invalidate_artifact_cache();
  if (pos == -1) {
      tmp = weapon;
      weapon = ret_null;
@@ -724,6 +729,7 @@ bool Character::has_active_item(const itype_id & id) const
 
 item Character::remove_weapon()
 {
+ invalidate_artifact_cache();
  item tmp = weapon;
  weapon = ret_null;
  return tmp;
@@ -931,23 +937,46 @@ void Character::drop_inventory_overflow() {
                inv.remove_randomly_by_volume( volume_carried() - volume_capacity() ) ) {
             g->m.add_item_or_charges( pos(), item_to_drop );
         }
+        invalidate_artifact_cache();
         add_msg_if_player( m_bad, _("Some items tumble to the ground.") );
     }
 }
 
 bool Character::has_artifact_with(const art_effect_passive effect) const
 {
-    if( weapon.has_effect_when_wielded( effect ) ) {
-        return true;
-    }
-    for( auto & i : worn ) {
-        if( i.has_effect_when_worn( effect ) ) {
-            return true;
+    if( !artifact_cache_valid ) {
+        artifact_effects_cache.reset();
+
+        const auto add_effects = [this]( const std::vector<art_effect_passive> &effects ) {
+            for( const auto &e : effects ) {
+                artifact_effects_cache.set( e );
+            }
+        };
+
+        if( weapon.type->artifact ) {
+            add_effects( weapon.type->artifact->effects_wielded );
+        }
+        for( const auto &i : worn ) {
+            if( i.type->artifact ) {
+                add_effects( i.type->artifact->effects_worn );
+            }
         }
+        // Carried effects apply to every item, including wielded, worn and nested ones.
+        visit_items( [&add_effects]( const item *it ) {
+            if( it->type->artifact ) {
+                add_effects( it->type->artifact->effects_carried );
+            }
+            return VisitResponse::NEXT;
+        } );
+
+        artifact_cache_valid = true;
     }
-    return has_item_with( [effect]( const item & it ) {
-        return it.has_effect_when_carried( effect );
-    } );
+    return artifact_effects_cache.test( effect );
+}
+
+void Character::invalidate_artifact_cache()
+{
+    artifact_cache_valid = false;
 }
 
 bool Character::is_wearing(const itype_id & it) const
@@ -3,6 +3,7 @@
 
 #include "visitable.h"
 #include "creature.h"
+#include "enums.h"
 #include "inventory.h"
 #include "bionics.h"
 #include "skill.h"
@@ -424,6 +425,12 @@ class Character : public Creature, public visitable<Character>
         void drop_inventory_overflow();
 
         bool has_artifact_with(const art_effect_passive effect) const;
+        /**
+         * Marks the cached set of passive artifact effects as stale, it will be rebuilt
+         * on the next call to @ref has_artifact_with. Must be called whenever wielded,
+         * worn or carried items change.
+         */
+        void invalidate_artifact_cache();
 
         // --------------- Clothing Stuff ---------------
         /** Returns true if the player is wearing the item. */
@@ -602,6 +609,13 @@ class Character : public Creature, public visitable<Character>
          */
         mutable pathfinding_settings path_settings;
 
+        /**
+         * Union of the passive effects of all wielded, worn and carried artifacts.
+         * Rebuilt lazily by @ref has_artifact_with, see @ref invalidate_artifact_cache.
+         */
+        mutable std::bitset<NUM_AEPS> artifact_effects_cache;
+        mutable bool artifact_cache_valid = false;
+
     private:
         /** Needs (hunger, thirst, fatigue, etc.) */
         int hunger;
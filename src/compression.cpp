@@ -0,0 +1,219 @@
+#include "compression.h"
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+/** Bytes of a file written by pack: magic, format version and uncompressed size. */
+const char packed_magic[] = { 'C', 'D', 'Z', '\x01' };
+constexpr size_t magic_size = sizeof( packed_magic );
+constexpr size_t header_size = magic_size + 4;
+
+constexpr size_t min_match = 4;
+/** The last bytes of a block are always literals. */
+constexpr size_t last_literals = 5;
+/** No match starts this close to the end of the block. */
+constexpr size_t match_find_limit = 12;
+constexpr size_t max_offset = 65535;
+constexpr int hash_bits = 14;
+
+inline uint32_t read32( const char *p )
+{
+    uint32_t result;
+    memcpy( &result, p, sizeof( result ) );
+    return result;
+}
+
+inline uint32_t hash_sequence( uint32_t sequence )
+{
+    return ( sequence * 2654435761u ) >> ( 32 - hash_bits );
+}
+
+/** Lengths that don't fit into the token nibble continue in bytes of 255 and a remainder. */
+void write_length( std::string &out, size_t length )
+{
+    while( length >= 255 ) {
+        out.push_back( static_cast<char>( 255 ) );
+        length -= 255;
+    }
+    out.push_back( static_cast<char>( length ) );
+}
+
+bool read_length( const unsigned char *data, size_t size, size_t &pos, size_t &length )
+{
+    unsigned char byte;
+    do {
+        if( pos >= size ) {
+            return false;
+        }
+        byte = data[pos++];
+        length += byte;
+    } while( byte == 255 );
+    return true;
+}
+
+void write_sequence( std::string &out, const char *literals, size_t literal_length,
+                     size_t offset, size_t match_length )
+{
+    const size_t match_code = match_length - min_match;
+    const unsigned char token = ( ( literal_length < 15 ? literal_length : 15 ) << 4 ) |
+                                ( match_code < 15 ? match_code : 15 );
+    out.push_back( static_cast<char>( token ) );
+    if( literal_length >= 15 ) {
+        write_length( out, literal_length - 15 );
+    }
+    out.append( literals, literal_length );
+    out.push_back( static_cast<char>( offset & 0xff ) );
+    out.push_back( static_cast<char>( offset >> 8 ) );
+    if( match_code >= 15 ) {
+        write_length( out, match_code - 15 );
+    }
+}
+
+void write_last_literals( std::string &out, const char *literals, size_t literal_length )
+{
+    const unsigned char token = ( literal_length < 15 ? literal_length : 15 ) << 4;
+    out.push_back( static_cast<char>( token ) );
+    if( literal_length >= 15 ) {
+        write_length( out, literal_length - 15 );
+    }
+    out.append( literals, literal_length );
+}
+
+} // namespace
+
+std::string compression::compress_block( const char *const data, const size_t size )
+{
+    std::string out;
+    out.reserve( size / 2 + 16 );
+    size_t anchor = 0;
+    if( size > match_find_limit ) {
+        std::vector<uint32_t> table( 1 << hash_bits, 0 );
+        const size_t limit = size - match_find_limit;
+        const size_t match_limit = size - last_literals;
+        size_t pos = 1;
+        while( pos <= limit ) {
+            const uint32_t sequence = read32( data + pos );
+            uint32_t &entry = table[hash_sequence( sequence )];
+            const size_t candidate = entry;
+            entry = pos;
+            if( candidate >= pos || pos - candidate > max_offset || read32( data + candidate ) != sequence ) {
+                // Skip faster through data that does not compress.
+                pos += 1 + ( ( pos - anchor ) >> 6 );
+                continue;
+            }
+            size_t length = min_match;
+            while( pos + length < match_limit && data[candidate + length] == data[pos + length] ) {
+                length++;
+            }
+            write_sequence( out, data + anchor, pos - anchor, pos - candidate, length );
+            pos += length;
+            anchor = pos;
+        }
+    }
+    write_last_literals( out, data + anchor, size - anchor );
+    return out;
+}
+
+bool compression::decompress_block( const char *const data, const size_t size,
+                                    const size_t decompressed_size, std::string &out )
+{
+    const unsigned char *const in = reinterpret_cast<const unsigned char *>( data );
+    out.assign( decompressed_size, '\0' );
+    char *const dest = &out[0];
+    size_t pos = 0;
+    size_t written = 0;
+    while( pos < size ) {
+        const unsigned char token = in[pos++];
+        size_t literal_length = token >> 4;
+        if( literal_length == 15 && !read_length( in, size, pos, literal_length ) ) {
+            return false;
+        }
+        if( literal_length > size - pos || literal_length > decompressed_size - written ) {
+            return false;
+        }
+        memcpy( dest + written, data + pos, literal_length );
+        pos += literal_length;
+        written += literal_length;
+        if( pos == size ) {
+            // The last sequence has no match.
+            break;
+        }
+
+        if( size - pos < 2 ) {
+            return false;
+        }
+        const size_t offset = in[pos] | ( in[pos + 1] << 8 );
+        pos += 2;
+        if( offset == 0 || offset > written ) {
+            return false;
+        }
+        size_t match_length = token & 15;
+        if( match_length == 15 && !read_length( in, size, pos, match_length ) ) {
+            return false;
+        }
+        match_length += min_match;
+        if( match_length > decompressed_size - written ) {
+            return false;
+        }
+        // The match may overlap the output it is copied to, so copy byte by byte.
+        const char *source = dest + written - offset;
+        for( size_t i = 0; i < match_length; i++ ) {
+            dest[written + i] = source[i];
+        }
+        written += match_length;
+    }
+    return written == decompressed_size;
+}
+
+std::string compression::pack( const std::string &content )
+{
+    if( content.size() > 0xffffffffu ) {
+        throw std::runtime_error( "content too large to compress" );
+    }
+    const uint32_t size = content.size();
+    std::string result( packed_magic, magic_size );
+    for( int i = 0; i < 4; i++ ) {
+        result.push_back( static_cast<char>( ( size >> ( 8 * i ) ) & 0xff ) );
+    }
+    result += compress_block( content.data(), content.size() );
+    return result;
+}
+
+std::string compression::unpack( const std::string &packed )
+{
+    if( !is_packed( packed ) || packed.size() < header_size ) {
+        throw std::runtime_error( "not a compressed file" );
+    }
+    size_t size = 0;
+    for( int i = 0; i < 4; i++ ) {
+        size |= static_cast<size_t>( static_cast<unsigned char>( packed[magic_size + i] ) ) << ( 8 * i );
+    }
+    std::string result;
+    if( !decompress_block( packed.data() + header_size, packed.size() - header_size, size, result ) ) {
+        throw std::runtime_error( "compressed data is corrupt" );
+    }
+    return result;
+}
+
+bool compression::is_packed( const std::string &content )
+{
+    return content.compare( 0, magic_size, packed_magic, magic_size ) == 0;
+}
+
+bool compression::is_packed( std::istream &stream )
+{
+    const auto start = stream.tellg();
+    char magic[magic_size];
+    stream.read( magic, magic_size );
+    const bool result = stream.gcount() == static_cast<std::streamsize>( magic_size ) &&
+                        memcmp( magic, packed_magic, magic_size ) == 0;
+    stream.clear();
+    stream.seekg( start );
+    return result;
+}
@@ -0,0 +1,50 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+/**
+ * A small LZ77 codec for save files.
+ *
+ * The blocks use the sequence format of LZ4 (a token with literal and match lengths,
+ * the literals and a 16 bit match offset), so they can be inspected with the usual
+ * tools. Compression is greedy with a single hash table lookup per position, which
+ * is fast and works well on the very repetitive JSON the game writes.
+ *
+ * Compressed files (see @ref pack) start with a short header that can never start a
+ * JSON value, so readers can tell them apart from plain files, see @ref is_packed.
+ */
+namespace compression
+{
+
+/** Compresses @p size bytes at @p data into a block. */
+std::string compress_block( const char *data, size_t size );
+/**
+ * Decompresses a block into @p out (which is replaced).
+ * @return false if the block is malformed or does not decompress to exactly
+ * @p decompressed_size bytes.
+ */
+bool decompress_block( const char *data, size_t size, size_t decompressed_size,
+                       std::string &out );
+
+/** Header and compressed block of @p content, the content of a compressed file. */
+std::string pack( const std::string &content );
+/**
+ * Reverses @ref pack.
+ * @throws std::runtime_error if @p packed is not the result of @ref pack.
+ */
+std::string unpack( const std::string &packed );
+
+/** Whether @p content starts with the header written by @ref pack. */
+bool is_packed( const std::string &content );
+/**
+ * Whether the stream continues with the header written by @ref pack. The stream
+ * position is not changed.
+ */
+bool is_packed( std::istream &stream );
+
+}
+
+#endif
@@ -178,6 +178,24 @@ const recipe *select_crafting_recipe( int &batch_size )
     const auto &available_recipes = g->u.get_available_recipes( crafting_inv, &helpers );
     std::map<const recipe *, bool> availability_cache;
 
+    // A longer query only needs to look at the results of the previous one
+    bool searched = false;
+    std::string last_query;
+    recipe_subset::search_type last_key = recipe_subset::search_type::name;
+    std::vector<const recipe *> last_results;
+    const auto search = [&]( const std::string & txt, const recipe_subset::search_type key ) {
+        const std::string query = fold_case( txt );
+        if( searched && key == last_key && query.find( last_query ) != std::string::npos ) {
+            last_results = available_recipes.search( txt, key, last_results );
+        } else {
+            last_results = available_recipes.search( txt, key );
+        }
+        searched = true;
+        last_query = query;
+        last_key = key;
+        return last_results;
+    };
+
     do {
         if( redraw ) {
             // When we switch tabs, redraw the header
@@ -212,30 +230,30 @@ const recipe *select_crafting_recipe( int &batch_size )
                     if( qry.size() > 2 && qry[1] == ':' ) {
                         switch( qry[0] ) {
                             case 't':
-                                current = available_recipes.search( qry.substr( 2 ), recipe_subset::search_type::tool );
+                                current = search( qry.substr( 2 ), recipe_subset::search_type::tool );
                                 break;
 
                             case 'c':
-                                current = available_recipes.search( qry.substr( 2 ), recipe_subset::search_type::component );
+                                current = search( qry.substr( 2 ), recipe_subset::search_type::component );
                                 break;
 
                             case 's':
-                                current = available_recipes.search( qry.substr( 2 ), recipe_subset::search_type::skill );
+                                current = search( qry.substr( 2 ), recipe_subset::search_type::skill );
                                 break;
 
                             case 'q':
-                                current = available_recipes.search( qry.substr( 2 ), recipe_subset::search_type::quality );
+                                current = search( qry.substr( 2 ), recipe_subset::search_type::quality );
                                 break;
 
                             case 'Q':
-                                current = available_recipes.search( qry.substr( 2 ), recipe_subset::search_type::quality_result );
+                                current = search( qry.substr( 2 ), recipe_subset::search_type::quality_result );
                                 break;
 
                             default:
                                 current.clear();
                         }
                     } else {
-                        current = available_recipes.search( qry );
+                        current = search( qry, recipe_subset::search_type::name );
                     }
                 }
                 available.reserve( current.size() );
@@ -719,19 +737,3 @@ int recipe::print_time( WINDOW *w, int ypos, int xpos, int width,
     text = string_format( _( "Time to complete: %s" ), text.c_str() );
     return fold_and_print( w, ypos, xpos, width, col, text );
 }
-
-// ui.cpp
-extern bool lcmatch( const std::string &str, const std::string &findstr );
-
-template<typename T>
-bool lcmatch_any( const std::vector< std::vector<T> > &list_of_list, const std::string &filter )
-{
-    for( auto &list : list_of_list ) {
-        for( auto &comp : list ) {
-            if( lcmatch( item::nname( comp.type ), filter ) ) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
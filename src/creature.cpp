@@ -14,6 +14,7 @@
 #include "debug.h"
 #include "field.h"
 #include "projectile.h"
+#include "memory_usage.h"
 
 #include <algorithm>
 #include <numeric>
@@ -268,7 +269,35 @@ bool overlaps_vehicle( const std::set<tripoint> &veh_area, const tripoint &pos,
     return false;
 }
 
+std::vector<Creature *> Creature::hostile_target_candidates()
+{
+    std::vector<Creature *> targets;
+    targets.reserve( g->num_zombies() + g->active_npc.size() );
+    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+        monster &m = g->zombie( i );
+        if( m.friendly != 0 ) {
+            // friendly to the player, not a target for us
+            continue;
+        }
+        targets.push_back( &m );
+    }
+    for( auto &p : g->active_npc ) {
+        if( p->attitude != NPCATT_KILL ) {
+            // friendly to the player, not a target for us
+            continue;
+        }
+        targets.push_back( p );
+    }
+    return targets;
+}
+
 Creature *Creature::auto_find_hostile_target( int range, int &boo_hoo, int area )
+{
+    return auto_find_hostile_target( range, boo_hoo, area, hostile_target_candidates() );
+}
+
+Creature *Creature::auto_find_hostile_target( int range, int &boo_hoo, int area,
+        const std::vector<Creature *> &targets )
 {
     Creature *target = nullptr;
     player &u = g->u; // Could easily protect something that isn't the player
@@ -301,23 +330,6 @@ Creature *Creature::auto_find_hostile_target( int range, int &boo_hoo, int area
         self_area_iff = true;
     }
 
-    std::vector<Creature*> targets;
-    targets.reserve( g->num_zombies() + g->active_npc.size() );
-    for (size_t i = 0; i < g->num_zombies(); i++) {
-        monster &m = g->zombie(i);
-        if( m.friendly != 0 ) {
-            // friendly to the player, not a target for us
-            continue;
-        }
-        targets.push_back( &m );
-    }
-    for( auto &p : g->active_npc ) {
-        if( p->attitude != NPCATT_KILL ) {
-            // friendly to the player, not a target for us
-            continue;
-        }
-        targets.push_back( p );
-    }
     for( auto &m : targets ) {
         if( !sees( *m ) ) {
             // can't see nor sense it
@@ -770,6 +782,20 @@ bool Creature::is_warm() const
     return true;
 }
 
+size_t Creature::estimate_memory_usage() const
+{
+    using namespace memory_usage;
+    size_t result = node_size( effects );
+    for( const auto &by_type : effects ) {
+        result += node_size( by_type.second );
+    }
+    result += node_size( values );
+    for( const auto &v : values ) {
+        result += heap_size( v.first ) + heap_size( v.second );
+    }
+    return result;
+}
+
 bool Creature::is_fake() const
 {
     return fake;
@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 class game;
 class JsonObject;
 class JsonOut;
@@ -78,6 +79,12 @@ class Creature
 
         /** Recreates the Creature from scratch. */
         virtual void normalize();
+
+        /**
+         * Estimated memory used by the creature, see memory_usage.h. This counts the heap
+         * memory of the effects, derived classes add their own members and their size.
+         */
+        virtual size_t estimate_memory_usage() const;
         /** Processes effects and bonuses and allocates move points based on speed. */
         virtual void process_turn();
         /** Resets the value of all bonus fields to 0. */
@@ -170,6 +177,14 @@ class Creature
          * @param area The area of effect of the projectile aimed.
          */
         Creature *auto_find_hostile_target( int range, int &boo_hoo, int area = 0);
+        /**
+         * Same as above, but only considers the given candidates. Shooters that look for
+         * targets at the same time can share the result of @ref hostile_target_candidates.
+         */
+        Creature *auto_find_hostile_target( int range, int &boo_hoo, int area,
+                                            const std::vector<Creature *> &candidates );
+        /** All creatures @ref auto_find_hostile_target may pick, those not friendly to the player. */
+        static std::vector<Creature *> hostile_target_candidates();
 
         /** Make a single melee attack with the currently equipped weapon against the targeted
          *  creature. Should always be overwritten by the appropriate player/NPC/monster function. */
@@ -16,6 +16,16 @@
 #include "npc.h"
 #include "ammo.h"
 #include "crafting.h"
+#include "memory_usage.h"
+
+bool game::dump_memory_usage( const std::string &world )
+{
+    if( !load( world ) ) {
+        return false;
+    }
+    std::cout << memory_usage::report_text();
+    return true;
+}
 
 bool game::dump_stats( const std::string& what, dump_mode mode, const std::vector<std::string> &opts )
 {
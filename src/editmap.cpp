@@ -488,7 +488,7 @@ void editmap::uber_draw_ter( WINDOW *w, map *m )
                     if( refresh_mplans == true ) {
                         monster *mon = dynamic_cast<monster *>( critter );
                         if( mon != nullptr && mon->pos() != mon->move_target() ) {
-                            for( auto &location : line_to( mon->pos(), mon->move_target() ) ) {
+                            for( const tripoint &location : line_view( mon->pos(), mon->move_target() ) ) {
                                 hilights["mplan"].points[location] = 1;
                             }
                         }
@@ -0,0 +1,54 @@
+#include "fake_shooter.h"
+
+#include "npc.h"
+#include "skill.h"
+
+#include <memory>
+
+namespace
+{
+
+/** Idle npcs for @ref fake_shooter, more than one is only needed when shots trigger more shots. */
+std::vector<std::unique_ptr<npc>> shooter_pool;
+size_t shooters_in_use = 0;
+
+void reset( npc &who, const shooter_profile &profile )
+{
+    who.set_fake( true );
+    who.name = profile.name;
+    who.setpos( profile.pos );
+    who.str_cur = who.str_max = profile.str;
+    who.dex_cur = who.dex_max = profile.dex;
+    who.int_cur = who.int_max = profile.intl;
+    who.per_cur = who.per_max = profile.per;
+    // Firing practices skills, so the levels and the exercise have to be reset.
+    for( const Skill &e : Skill::skills ) {
+        who.get_skill_level( e.ident() ) = SkillLevel( profile.base_skill );
+    }
+    for( const auto &e : profile.skills ) {
+        who.set_skill_level( e.first, e.second );
+    }
+    who.attitude = profile.friendly ? NPCATT_FOLLOW : NPCATT_KILL;
+    who.recoil = profile.recoil;
+    who.moves = 100;
+    who.clear_effects();
+    who.weapon = item();
+    who.inv.clear();
+    who.worn.clear();
+}
+
+} // namespace
+
+fake_shooter::fake_shooter( const shooter_profile &profile )
+{
+    if( shooters_in_use == shooter_pool.size() ) {
+        shooter_pool.emplace_back( new npc() );
+    }
+    who = shooter_pool[shooters_in_use++].get();
+    reset( *who, profile );
+}
+
+fake_shooter::~fake_shooter()
+{
+    shooters_in_use--;
+}
@@ -0,0 +1,59 @@
+#ifndef FAKE_SHOOTER_H
+#define FAKE_SHOOTER_H
+
+#include "enums.h"
+#include "string_id.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class npc;
+class Skill;
+using skill_id = string_id<Skill>;
+
+/**
+ * Everything about the one firing a gun that matters to @ref player::fire_gun when it is not
+ * a real character: vehicle turrets and monsters with guns.
+ */
+struct shooter_profile {
+    std::string name;
+    tripoint pos;
+    int str = 8;
+    int dex = 8;
+    int intl = 8;
+    int per = 8;
+    /** Level of all skills that are not listed in @ref skills. */
+    int base_skill = 0;
+    std::vector<std::pair<skill_id, int>> skills;
+    /** Friendly shooters don't target the player or their allies. */
+    bool friendly = false;
+    double recoil = 0;
+};
+
+/**
+ * A hidden npc set up as described by a @ref shooter_profile. Constructing an npc is
+ * expensive, so they are kept in a pool and only reset for the next shooter.
+ * The npc is only valid as long as this object exists.
+ */
+class fake_shooter
+{
+    public:
+        explicit fake_shooter( const shooter_profile &profile );
+        ~fake_shooter();
+
+        fake_shooter( const fake_shooter & ) = delete;
+        fake_shooter &operator=( const fake_shooter & ) = delete;
+
+        npc &operator*() const {
+            return *who;
+        }
+        npc *operator->() const {
+            return who;
+        }
+
+    private:
+        npc *who;
+};
+
+#endif
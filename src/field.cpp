@@ -20,6 +20,7 @@
 #include "scent_map.h"
 
 #include <queue>
+#include <set>
 
 const species_id FUNGUS( "FUNGUS" );
 
@@ -466,35 +467,37 @@ field_id field_from_ident(const std::string &field_ident)
 
 bool map::process_fields()
 {
-    bool dirty_transparency_cache = false;
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
-    bool zlev_dirty;
+    // Submaps whose fields may change, fields can spread into neighboring submaps and
+    // z-levels, so the caches are only updated after all of them were processed.
+    std::set<tripoint> touched;
     for( int z = minz; z <= maxz; z++ ) {
-        zlev_dirty = false;
         for( int x = 0; x < my_MAPSIZE; x++ ) {
             for( int y = 0; y < my_MAPSIZE; y++ ) {
                 submap * const current_submap = get_submap_at_grid( x, y, z );
                 if( current_submap->field_count > 0 ) {
-                    const bool cur_dirty = process_fields_in_submap( current_submap, x, y, z );
-                    zlev_dirty |= cur_dirty;
+                    touched.emplace( x, y, z );
+                    process_fields_in_submap( current_submap, x, y, z );
                 }
             }
         }
+    }
 
-        if( zlev_dirty ) {
-            // For now, just always dirty the transparency cache
-            // when a field might possibly be changed.
-            // TODO: check if there are any fields(mostly fire)
-            //       that frequently change, if so set the dirty
-            //       flag, otherwise only set the dirty flag if
-            //       something actually changed
-            set_transparency_cache_dirty( z );
-            dirty_transparency_cache = true;
+    // Only the entries of tiles whose fields changed their transparency are updated.
+    bool changed = false;
+    for( int z = minz; z <= maxz; z++ ) {
+        for( int x = 0; x < my_MAPSIZE; x++ ) {
+            for( int y = 0; y < my_MAPSIZE; y++ ) {
+                if( touched.count( tripoint( x, y, z ) ) > 0 ||
+                    get_submap_at_grid( x, y, z )->field_count > 0 ) {
+                    changed |= update_transparency_cache( x, y, z );
+                }
+            }
         }
     }
 
-    return dirty_transparency_cache;
+    return changed;
 }
 
 bool ter_furn_has_flag( const ter_t &ter, const furn_t &furn, const ter_bitflags flag )
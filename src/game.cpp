@@ -3,6 +3,8 @@
 #include "coordinate_conversions.h"
 #include "rng.h"
 #include "input.h"
+#include "input_replay.h"
+#include "memory_usage.h"
 #include "output.h"
 #include "skill.h"
 #include "line.h"
@@ -88,6 +90,8 @@
 #include "gates.h"
 #include "item_factory.h"
 #include "scent_map.h"
+#include "turn_pipeline.h"
+#include "scratch_arena.h"
 #include "safemode_ui.h"
 #include "game_constants.h"
 
@@ -714,9 +718,7 @@ void game::reenter_fullscreen(void)
 void game::setup()
 {
     popup_status( _( "Please wait while the world data loads..." ), _( "Loading core data" ) );
-    load_core_data();
-
-    load_world_modfiles(world_generator->active_world);
+    load_world_data( world_generator->active_world );
 
     m =  map( get_world_option<bool>( "ZLEVELS" ) );
 
@@ -1394,6 +1396,8 @@ bool game::do_turn()
     if (is_game_over()) {
         return cleanup_at_end();
     }
+    // Temporary containers of the last turn are all gone by now.
+    turn_arena().reset();
     // Actual stuff
     if( new_game ) {
         new_game = false;
@@ -1402,6 +1406,8 @@ bool game::do_turn()
         calendar::turn.increment();
     }
 
+    input_replay::on_turn_start();
+
     if( npcs_dirty ) {
         load_npcs();
     }
@@ -1504,39 +1510,7 @@ bool game::do_turn()
         scent.set( u.pos(), u.scent );
         overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
     }
-    scent.update( u.pos(), m );
-
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
-
-    m.process_falling();
-    m.vehmove();
-
-    // Process power and fuel consumption for all vehicles, including off-map ones.
-    // m.vehmove used to do this, but now it only give them moves instead.
-    for( auto &elem : MAPBUFFER ) {
-        tripoint sm_loc = elem.first;
-        point sm_topleft = sm_to_ms_copy(sm_loc.x, sm_loc.y);
-        point in_reality = m.getlocal(sm_topleft);
-
-        submap *sm = elem.second;
-
-        const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
-        for( auto &veh : sm->vehicles ) {
-            veh->idle( in_bubble_z && m.inbounds(in_reality.x, in_reality.y) );
-        }
-    }
-    m.process_fields();
-    m.process_active_items();
-    m.creature_in_field( u );
-
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( get_levz(), true );
-    monmove();
-    update_stair_monsters();
+    process_world_turn();
     u.process_turn();
     if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
         draw();
@@ -1574,6 +1548,66 @@ bool game::do_turn()
     return false;
 }
 
+void game::process_world_turn()
+{
+    // Everything that moves, fights or burns may use the random number generator and print
+    // messages, so most stages have to run in order.
+    constexpr unsigned world = TD_ALL & ~( TD_SCENT | TD_WEATHER );
+    turn_pipeline stages;
+    stages.add( "scent", TD_TERRAIN | TD_VEHICLES | TD_CREATURES | TD_SCENT, TD_SCENT, [this]() {
+        scent.update( u.pos(), m );
+    } );
+    // We need floor cache before checking falling 'n stuff
+    stages.add( "floor caches", TD_TERRAIN | TD_MAP_CACHES, TD_MAP_CACHES, [this]() {
+        m.build_floor_caches();
+    } );
+    stages.add( "falling", TD_ALL, world, [this]() {
+        m.process_falling();
+    } );
+    stages.add( "vehicle movement", TD_ALL, world, [this]() {
+        m.vehmove();
+    } );
+    // Process power and fuel consumption for all vehicles, including off-map ones.
+    // m.vehmove used to do this, but now it only give them moves instead.
+    stages.add( "vehicle upkeep", TD_ALL, world, [this]() {
+        for( auto &elem : MAPBUFFER ) {
+            tripoint sm_loc = elem.first;
+            point sm_topleft = sm_to_ms_copy( sm_loc.x, sm_loc.y );
+            point in_reality = m.getlocal( sm_topleft );
+
+            submap *sm = elem.second;
+
+            const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
+            for( auto &veh : sm->vehicles ) {
+                veh->idle( in_bubble_z && m.inbounds( in_reality.x, in_reality.y ) );
+            }
+        }
+    } );
+    stages.add( "fields", TD_ALL, world, [this]() {
+        m.process_fields();
+    } );
+    stages.add( "active items", TD_ALL, world, [this]() {
+        m.process_active_items();
+    } );
+    stages.add( "player in fields", TD_ALL, world, [this]() {
+        m.creature_in_field( u );
+    } );
+    // Apply sounds from previous turn to monster and NPC AI.
+    stages.add( "sounds", TD_ALL, world, []() {
+        sounds::process_sounds();
+    } );
+    // Update vision caches for monsters. If this turns out to be expensive,
+    // consider a stripped down cache just for monsters.
+    stages.add( "map caches", TD_ALL, TD_MAP_CACHES, [this]() {
+        m.build_map_cache( get_levz(), true );
+    } );
+    stages.add( "monsters", TD_ALL, world, [this]() {
+        monmove();
+        update_stair_monsters();
+    } );
+    stages.run();
+}
+
 void game::set_driving_view_offset(const point &p)
 {
     // remove the previous driving offset,
@@ -3693,7 +3727,77 @@ void game::load(std::string worldname, std::string name)
     }
 
     u.reset();
-    draw();
+    if( !test_mode ) {
+        draw();
+    }
+}
+
+static void sanitize_mod_order( std::vector<std::string> &mods,
+                                const std::function<bool( const std::string & )> &is_core )
+{
+    // remove any duplicates whilst preserving order (fixes #19385)
+    std::set<std::string> found;
+    mods.erase( std::remove_if( mods.begin(), mods.end(), [&found]( const std::string &e ) {
+        if( found.count( e ) ) {
+            return true;
+        } else {
+            found.insert( e );
+            return false;
+        }
+    } ), mods.end() );
+
+    // require at least one core mod (saves before version 6 may implicitly require dda pack)
+    if( std::none_of( mods.begin(), mods.end(), is_core ) ) {
+        mods.insert( mods.begin(), "dda" );
+    }
+}
+
+void game::load_world_data( WORLDPTR world )
+{
+    if( world ) {
+        sanitize_mod_order( world->active_mod_order, []( const std::string &e ) {
+            return world_generator->get_mod_manager()->mod_map[e]->core;
+        } );
+    }
+    auto &loader = DynamicDataLoader::get_instance();
+    const std::string fingerprint = data_fingerprint( world );
+    if( loader.loaded_fingerprint().empty() || loader.loaded_fingerprint() != fingerprint ) {
+        load_core_data();
+        load_world_modfiles( world );
+        loader.set_loaded_fingerprint( fingerprint );
+        return;
+    }
+
+    // The same files as for the previous world, only its artifacts have to be replaced.
+    item_controller->clear_runtime_types();
+    if( world ) {
+        load_artifacts( world->world_path + "/artifacts.gsav" );
+    }
+}
+
+std::string game::data_fingerprint( WORLDPTR world ) const
+{
+    std::vector<std::string> paths = { FILENAMES["jsondir"], FILENAMES["luadir"] };
+    std::string mod_list;
+    if( world ) {
+        mod_manager *mm = world_generator->get_mod_manager();
+        const int version = get_world_option<int>( "CORE_VERSION" );
+        for( const auto &e : world->active_mod_order ) {
+            mod_list += e + '\n';
+            if( !mm->has_mod( e ) ) {
+                continue;
+            }
+            const MOD_INFORMATION &mod = *mm->mod_map[e];
+            paths.push_back( mod.path );
+            if( !mod.legacy.empty() ) {
+                for( int i = version; i < core_version; ++i ) {
+                    paths.push_back( string_format( "%s/%i", mod.legacy.c_str(), i ) );
+                }
+            }
+        }
+        paths.push_back( world->world_path + "/mods" );
+    }
+    return mod_list + DynamicDataLoader::fingerprint( paths );
 }
 
 void game::load_world_modfiles(WORLDPTR world)
@@ -3703,24 +3807,9 @@ void game::load_world_modfiles(WORLDPTR world)
 
     if( world ) {
         auto &mods = world->active_mod_order;
-
-        // remove any duplicates whilst preserving order (fixes #19385)
-        std::set<std::string> found;
-        mods.erase( std::remove_if( mods.begin(), mods.end(), [&found]( const std::string &e ) {
-            if( found.count( e ) ) {
-                return true;
-            } else {
-                found.insert( e );
-                return false;
-            }
-        } ), mods.end() );
-
-        // require at least one core mod (saves before version 6 may implicitly require dda pack)
-        if( std::none_of( mods.begin(), mods.end(), []( const std::string &e ) {
+        sanitize_mod_order( mods, []( const std::string &e ) {
             return world_generator->get_mod_manager()->mod_map[e]->core;
-        } ) ) {
-            mods.insert( mods.begin(), "dda" );
-        }
+        } );
 
         load_artifacts(world->world_path + "/artifacts.gsav");
         // this code does not care about mod dependencies,
@@ -3825,7 +3914,7 @@ bool game::save_player_data()
 
     const bool saved_data = write_to_file( playerfile + ".sav", [&]( std::ostream &fout ) {
         serialize(fout);
-    }, _( "player data" ) );
+    }, _( "player data" ), get_option<bool>( "SAVE_COMPRESSION" ) );
     const bool saved_weather = write_to_file( playerfile + ".weather", [&]( std::ostream &fout ) {
         save_weather(fout);
     }, _( "weather state" ) );
@@ -4049,6 +4138,7 @@ void game::debug()
                        _( "Overmap editor" ),         // 30
                        _( "Draw benchmark (5 seconds)" ),    // 31
                        _( "Teleport - Adjacent overmap" ),   // 32
+                       _( "Memory usage" ),           // 33
                        _( "Cancel" ),
                        NULL );
     int veh_num;
@@ -4402,6 +4492,10 @@ void game::debug()
         case 32:
             debug_menu::teleport_overmap();
             break;
+
+        case 33:
+            popup( memory_usage::report_text(), PF_NONE );
+            break;
     }
     erase();
     refresh_all();
@@ -5914,6 +6008,24 @@ void game::cleanup_dead()
     }
 }
 
+bool game::monster_ai_is_low_detail( monster &critter, const int lod_distance )
+{
+    if( critter.friendly != 0 || critter.has_effect( effect_controlled ) ) {
+        return false;
+    }
+    for( const npc *guy : active_npc ) {
+        if( rl_dist( critter.pos(), guy->pos() ) <= lod_distance ) {
+            return false;
+        }
+    }
+    const int dist = rl_dist( critter.pos(), u.pos() );
+    if( dist > lod_distance ) {
+        return true;
+    }
+    // Closer monsters only while they are wandering about out of the line of sight of the player.
+    return dist > lod_distance / 2 && critter.wander() && !m.pl_line_of_sight( critter.pos(), -1 );
+}
+
 void game::monmove()
 {
     cleanup_dead();
@@ -5923,6 +6035,8 @@ void game::monmove()
 
     mfactions monster_factions;
     const auto &playerfaction = mfaction_str_id( "player" );
+    const int lod_distance = get_option<int>( "MONSTER_AI_LOD_DISTANCE" );
+    const int lod_interval = get_option<int>( "MONSTER_AI_LOD_INTERVAL" );
     for (size_t i = 0; i < num_zombies(); i++) {
         // The first time through, and any time the map has been shifted,
         // recalculate monster factions.
@@ -5976,12 +6090,31 @@ void game::monmove()
 
         m.creature_in_field( critter );
 
+        // Monsters far from anything interesting only act every few turns, their moves
+        // accumulate in the meantime and are spent along a single plan.
+        const bool low_detail = lod_interval > 1 && !critter.is_dead() &&
+                                monster_ai_is_low_detail( critter, lod_distance );
+        if( !low_detail ) {
+            critter.ai_deferred_turns = -1;
+        } else {
+            if( critter.ai_deferred_turns < 0 ) {
+                // Spread the monsters over the turns of the interval.
+                critter.ai_deferred_turns = i % lod_interval;
+            }
+            if( ++critter.ai_deferred_turns < lod_interval ) {
+                continue;
+            }
+            critter.ai_deferred_turns = 0;
+        }
+
+        bool planned = false;
         while (critter.moves > 0 && !critter.is_dead()) {
             critter.made_footstep = false;
             // Controlled critters don't make their own plans
-            if (!critter.has_effect( effect_controlled)) {
+            if( !critter.has_effect( effect_controlled ) && ( !low_detail || !planned ) ) {
                 // Formulate a path to follow
                 critter.plan( monster_factions );
+                planned = true;
             }
             critter.move(); // Move one square, possibly hit u
             critter.process_triggers();
@@ -13156,17 +13289,33 @@ void game::update_overmap_seen()
     const int dist = u.overmap_sight_range(light_level( u.posz() ));
     // We can always see where we're standing
     overmap_buffer.set_seen(ompos.x, ompos.y, ompos.z, true);
-    for (int x = ompos.x - dist; x <= ompos.x + dist; x++) {
-        for (int y = ompos.y - dist; y <= ompos.y + dist; y++) {
-            const std::vector<point> line = line_to(ompos.x, ompos.y, x, y, 0);
+    if( dist < 0 ) {
+        return;
+    }
+    // Fetch the see cost of every tile in range once, instead of once per line step.
+    const int width = 2 * dist + 1;
+    std::vector<int> see_cost( width * width );
+    for( int y = 0; y < width; y++ ) {
+        for( int x = 0; x < width; x++ ) {
+            const oter_id &ter = overmap_buffer.ter( ompos.x - dist + x, ompos.y - dist + y, ompos.z );
+            see_cost[y * width + x] = int( ter->get_see_cost() );
+        }
+    }
+    // Bresenham lines are not prefix-closed, so every target is still walked individually
+    // (matching line_to), but only over the local cost grid and without allocating.
+    for( int y = 0; y < width; y++ ) {
+        for( int x = 0; x < width; x++ ) {
             int sight_points = dist;
-            for (std::vector<point>::const_iterator it = line.begin();
-                 it != line.end() && sight_points >= 0; ++it) {
-                const oter_id &ter = overmap_buffer.ter(it->x, it->y, ompos.z);
-                sight_points -= int( ter->get_see_cost() );
+            if( x == dist && y == dist ) {
+                sight_points -= see_cost[y * width + x];
+            } else {
+                bresenham( dist, dist, x, y, 0, [&]( const point &p ) {
+                    sight_points -= see_cost[p.y * width + p.x];
+                    return sight_points >= 0;
+                } );
             }
-            if (sight_points >= 0) {
-                overmap_buffer.set_seen(x, y, ompos.z, true);
+            if( sight_points >= 0 ) {
+                overmap_buffer.set_seen( ompos.x - dist + x, ompos.y - dist + y, ompos.z, true );
             }
         }
     }
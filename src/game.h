@@ -151,6 +151,14 @@ class game
 
         /** Loads core data and mods from the given world. May throw. */
         void load_world_modfiles(WORLDPTR world);
+        /**
+         * Loads core data and mods of the given world like @ref load_core_data and
+         * @ref load_world_modfiles, but keeps the data that is already loaded if it came
+         * from the same files. May throw.
+         */
+        void load_world_data( WORLDPTR world );
+        /** Fingerprint (see @ref DynamicDataLoader::fingerprint) of the data the world uses. */
+        std::string data_fingerprint( WORLDPTR world ) const;
 
         /**
          *  Load content packs
@@ -191,6 +199,8 @@ class game
 
         /** write statisics to stdout and @return true if sucessful */
         bool dump_stats( const std::string& what, dump_mode mode, const std::vector<std::string> &opts );
+        /** load the first save of the world and write its memory usage to stdout, @return true if sucessful */
+        bool dump_memory_usage( const std::string &world );
 
         /** Returns false if saving failed. */
         bool save();
@@ -205,6 +215,19 @@ class game
         void start_calendar();
         /** MAIN GAME LOOP. Returns true if game is over (death, saved, quit, etc.). */
         bool do_turn();
+        /**
+         * Updates the reality bubble after the player acted: scent, map caches, vehicles,
+         * fields, items, sounds and creatures. Runs as a @ref turn_pipeline, stages that use
+         * disjoint data may run concurrently.
+         */
+        void process_world_turn();
+        /** Processes the monsters and active NPCs for one turn. */
+        void monmove();
+        /**
+         * Whether the monster is far from anything interesting, so its AI runs at a reduced
+         * frequency, see the "MONSTER_AI_LOD_*" options.
+         */
+        bool monster_ai_is_low_detail( monster &critter, int lod_distance );
         void draw();
         void draw_ter( bool draw_sounds = true );
         void draw_ter( const tripoint &center, bool looking = false, bool draw_sounds = true );
@@ -844,7 +867,6 @@ private:
 
         // Routine loop functions, approximately in order of execution
         void cleanup_dead();     // Delete any dead NPCs/monsters
-        void monmove();          // Monster movement
         void rustCheck();        // Degrades practice levels
         void process_events();   // Processes and enacts long-term events
         void process_activity(); // Processes and enacts the player's activity
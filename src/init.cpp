@@ -58,12 +58,15 @@
 #include "npc_class.h"
 #include "recipe_dictionary.h"
 #include "harvest.h"
+#include "memory_usage.h"
+#include "task_scheduler.h"
 
 #include <string>
 #include <vector>
 #include <fstream>
 #include <sstream> // for throwing errors
 #include <locale> // for loading names
+#include <sys/stat.h>
 
 DynamicDataLoader::DynamicDataLoader()
 {
@@ -243,6 +246,7 @@ void DynamicDataLoader::initialize()
 
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src )
 {
+    memory_usage::tag_scope tag( memory_usage::tag::game_data );
     // We assume that each folder is consistent in itself,
     // and all the previously loaded folders.
     // E.g. the core might provide a vpart "frame-x"
@@ -259,18 +263,19 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back(path);
         }
     }
+    // Reading the files doesn't depend on anything that was loaded, so stuff them all into
+    // ram at once. They are loaded in order afterwards.
+    const auto contents = tasks::parallel_transform<std::string>( 0, files.size(), 8,
+    [&files]( const size_t i ) {
+        memory_usage::tag_scope tag( memory_usage::tag::game_data );
+        std::ifstream infile( files[i].c_str(), std::ifstream::in | std::ifstream::binary );
+        return std::string( ( std::istreambuf_iterator<char>( infile ) ),
+                            std::istreambuf_iterator<char>() );
+    } );
     // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        std::ifstream infile(file.c_str(), std::ifstream::in | std::ifstream::binary);
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                (std::istreambuf_iterator<char>(infile)),
-                std::istreambuf_iterator<char>()
-            )
-        );
+    for( size_t i = 0; i < files.size(); i++ ) {
+        const std::string &file = files[i];
+        std::istringstream iss( contents[i] );
         try {
             // parse it
             JsonIn jsin(iss);
@@ -316,6 +321,7 @@ void init_names()
 
 void DynamicDataLoader::unload_data()
 {
+    loaded_data_fingerprint.clear();
     json_flag::reset();
     requirement_data::reset();
     vitamin::reset();
@@ -366,9 +372,33 @@ void DynamicDataLoader::unload_data()
     //    NameGenerator::generator().clear_names();
 }
 
+std::string DynamicDataLoader::fingerprint( const str_vec &paths )
+{
+    std::ostringstream result;
+    for( const std::string &path : paths ) {
+        struct stat info;
+        if( stat( path.c_str(), &info ) != 0 ) {
+            continue;
+        }
+        str_vec files;
+        if( S_ISDIR( info.st_mode ) ) {
+            files = get_files_from_path( "", path, true );
+        } else {
+            files.push_back( path );
+        }
+        for( const std::string &file : files ) {
+            if( stat( file.c_str(), &info ) == 0 ) {
+                result << file << ' ' << info.st_size << ' ' << info.st_mtime << '\n';
+            }
+        }
+    }
+    return result.str();
+}
+
 extern void calculate_mapgen_weights();
 void DynamicDataLoader::finalize_loaded_data()
 {
+    memory_usage::tag_scope tag( memory_usage::tag::game_data );
     item_controller->finalize();
     requirement_data::finalize();
     vpart_info::finalize();
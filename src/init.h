@@ -127,6 +127,27 @@ class DynamicDataLoader
          * @return whether all entries were sucessfully loaded
          */
         bool load_deferred( deferred_json &data );
+
+        /**
+         * Describes the files found (recursively) in @p paths by name, size and
+         * modification time. Missing paths don't contribute anything. Loading the same
+         * paths again gives the same data as long as the result does not change.
+         */
+        static std::string fingerprint( const str_vec &paths );
+        /**
+         * The fingerprint of the files the currently loaded data came from. It is empty
+         * if the data was not loaded as a whole (see @ref game::load_world_data) and
+         * it is cleared by @ref unload_data.
+         */
+        const std::string &loaded_fingerprint() const {
+            return loaded_data_fingerprint;
+        }
+        void set_loaded_fingerprint( const std::string &fingerprint ) {
+            loaded_data_fingerprint = fingerprint;
+        }
+
+    private:
+        std::string loaded_data_fingerprint;
 };
 
 void init_names();
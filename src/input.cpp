@@ -1,6 +1,7 @@
 #include "action.h"
 #include "cursesdef.h"
 #include "input.h"
+#include "input_replay.h"
 #include "debug.h"
 #include "json.h"
 #include "output.h"
@@ -1096,9 +1097,21 @@ long input_manager::get_previously_pressed_key() const
     return previously_pressed_key;
 }
 
+input_event input_manager::get_input_event( WINDOW *win )
+{
+    if( input_replay::is_replaying() ) {
+        const input_event evt = input_replay::next_event();
+        previously_pressed_key = evt.type == CATA_INPUT_KEYBOARD ? evt.get_first_input() : 0;
+        return evt;
+    }
+    const input_event evt = read_input_event( win );
+    input_replay::record( evt );
+    return evt;
+}
+
 #ifndef TILES
-// If we're using curses, we need to provide get_input_event() here.
-input_event input_manager::get_input_event( WINDOW * /*win*/ )
+// If we're using curses, we need to provide read_input_event() here.
+input_event input_manager::read_input_event( WINDOW * /*win*/ )
 {
     previously_pressed_key = 0;
     long key = getch();
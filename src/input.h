@@ -192,7 +192,7 @@ class input_manager
         /**
          * curses getch() replacement.
          *
-         * Defined in the respective platform wrapper, e.g. sdlcurse.cpp
+         * Returns the recorded events when replaying a session, see input_replay.h.
          */
         input_event get_input_event( WINDOW *win );
 
@@ -209,6 +209,13 @@ class input_manager
     private:
         friend class input_context;
 
+        /**
+         * Reads the next event from the user, used by @ref get_input_event.
+         *
+         * Defined in the respective platform wrapper, e.g. sdlcurse.cpp
+         */
+        input_event read_input_event( WINDOW *win );
+
         typedef std::vector<input_event> t_input_event_list;
         typedef std::map<std::string, action_attributes> t_actions;
         typedef std::map<std::string, t_actions> t_action_contexts;
@@ -0,0 +1,349 @@
+#include "input_replay.h"
+
+#include "calendar.h"
+#include "cursesdef.h"
+#include "debug.h"
+#include "game.h"
+#include "input.h"
+#include "monster.h"
+#include "npc.h"
+#include "player.h"
+#include "worldfactory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+const std::string session_magic = "# cataclysm input session 1";
+
+enum class replay_mode : int {
+    none,
+    record,
+    replay
+};
+
+struct session_record {
+    /** Turn boundaries have no event, only the turn and the checksum. */
+    bool is_turn = false;
+    int turn = 0;
+    unsigned long checksum = 0;
+    input_event evt;
+};
+
+struct turn_report {
+    int turn;
+    long long microseconds;
+    unsigned long expected;
+    unsigned long actual;
+};
+
+replay_mode mode = replay_mode::none;
+std::string session_path;
+int session_seed = 0;
+std::string session_world;
+
+// Recording state
+std::ofstream record_file;
+bool header_written = false;
+
+// Replay state
+std::vector<session_record> records;
+size_t next_record = 0;
+std::vector<turn_report> reports;
+std::chrono::steady_clock::time_point turn_start;
+size_t desyncs = 0;
+
+void reseed( int turn )
+{
+    srand( session_seed ^ ( turn * 2654435761u ) );
+}
+
+// Text is written as hex, so it never contains white space or line breaks.
+std::string encode_text( const std::string &text )
+{
+    if( text.empty() ) {
+        return "-";
+    }
+    static const char *digits = "0123456789abcdef";
+    std::string result;
+    for( const unsigned char c : text ) {
+        result += digits[c >> 4];
+        result += digits[c & 0xf];
+    }
+    return result;
+}
+
+std::string decode_text( const std::string &text )
+{
+    std::string result;
+    if( text == "-" ) {
+        return result;
+    }
+    for( size_t i = 0; i + 1 < text.size(); i += 2 ) {
+        result += static_cast<char>( std::stoi( text.substr( i, 2 ), nullptr, 16 ) );
+    }
+    return result;
+}
+
+void write_header()
+{
+    record_file << session_magic << "\n";
+    record_file << "seed " << session_seed << "\n";
+    record_file << "world " << world_generator->active_world->world_name << "\n";
+    record_file << "save " << g->u.name << "\n";
+    record_file << "turn " << int( calendar::turn ) << "\n";
+    header_written = true;
+}
+
+void write_report()
+{
+    std::ofstream fout( session_path + ".report" );
+    fout << "turn\tmicroseconds\texpected_checksum\tactual_checksum\n";
+    long long total = 0;
+    long long worst = 0;
+    size_t mismatches = 0;
+    for( const auto &r : reports ) {
+        fout << r.turn << "\t" << r.microseconds << "\t" << r.expected << "\t" << r.actual << "\n";
+        total += r.microseconds;
+        worst = std::max( worst, r.microseconds );
+        mismatches += r.expected != r.actual;
+    }
+    std::ostringstream summary;
+    summary << "Replayed " << reports.size() << " turns in " << total / 1000 << " ms, "
+            << "average " << ( reports.empty() ? 0 : total / ( long long )reports.size() ) << " us, "
+            << "worst " << worst << " us, " << mismatches << " checksum mismatches, "
+            << desyncs << " input desyncs";
+    fout << "# " << summary.str() << "\n";
+    DebugLog( D_INFO, DC_ALL ) << summary.str();
+}
+
+void finish_replay()
+{
+    write_report();
+    mode = replay_mode::none;
+    // The replayed session must not be saved, the recorded save has to stay unchanged.
+    endwin();
+    exit( desyncs > 0 ? 1 : 0 );
+}
+
+} // namespace
+
+void input_replay::start_recording( const std::string &path, int seed )
+{
+    record_file.open( path.c_str(), std::ios::out | std::ios::trunc );
+    if( !record_file.is_open() ) {
+        debugmsg( "Could not open %s for recording", path.c_str() );
+        return;
+    }
+    session_path = path;
+    session_seed = seed;
+    header_written = false;
+    mode = replay_mode::record;
+}
+
+bool input_replay::start_replay( const std::string &path )
+{
+    std::ifstream fin( path.c_str() );
+    std::string line;
+    if( !fin.is_open() || !std::getline( fin, line ) || line != session_magic ) {
+        return false;
+    }
+
+    records.clear();
+    while( std::getline( fin, line ) ) {
+        std::istringstream in( line );
+        std::string tag;
+        in >> tag;
+        if( tag == "seed" ) {
+            in >> session_seed;
+        } else if( tag == "world" ) {
+            in >> std::ws;
+            std::getline( in, session_world );
+        } else if( tag == "T" ) {
+            session_record rec;
+            rec.is_turn = true;
+            in >> rec.turn >> rec.checksum;
+            records.push_back( rec );
+        } else if( tag == "E" ) {
+            session_record rec;
+            int type = 0;
+            size_t num = 0;
+            std::string text;
+            in >> type >> rec.evt.mouse_x >> rec.evt.mouse_y;
+            rec.evt.type = static_cast<input_event_t>( type );
+            in >> num;
+            rec.evt.modifiers.resize( num );
+            for( auto &m : rec.evt.modifiers ) {
+                in >> m;
+            }
+            in >> num;
+            rec.evt.sequence.resize( num );
+            for( auto &s : rec.evt.sequence ) {
+                in >> s;
+            }
+            in >> text;
+            rec.evt.text = decode_text( text );
+            records.push_back( rec );
+        }
+        // Other header lines (save name, start turn) are informative only.
+    }
+
+    session_path = path;
+    next_record = 0;
+    reports.clear();
+    desyncs = 0;
+    mode = replay_mode::replay;
+    return true;
+}
+
+void input_replay::stop()
+{
+    if( record_file.is_open() ) {
+        record_file.close();
+    }
+    records.clear();
+    mode = replay_mode::none;
+}
+
+bool input_replay::is_recording()
+{
+    return mode == replay_mode::record;
+}
+
+bool input_replay::is_replaying()
+{
+    return mode == replay_mode::replay;
+}
+
+const std::string &input_replay::replay_world()
+{
+    return session_world;
+}
+
+int input_replay::replay_seed()
+{
+    return session_seed;
+}
+
+void input_replay::record( const input_event &evt )
+{
+    // Input before the first turn (main menu, world selection) is not part of the session.
+    if( mode != replay_mode::record || !header_written ) {
+        return;
+    }
+    record_file << "E " << static_cast<int>( evt.type ) << " " << evt.mouse_x << " " << evt.mouse_y;
+    record_file << " " << evt.modifiers.size();
+    for( const long m : evt.modifiers ) {
+        record_file << " " << m;
+    }
+    record_file << " " << evt.sequence.size();
+    for( const long s : evt.sequence ) {
+        record_file << " " << s;
+    }
+    record_file << " " << encode_text( evt.text ) << "\n";
+}
+
+input_event input_replay::next_event()
+{
+    if( next_record >= records.size() ) {
+        finish_replay();
+        return input_event();
+    }
+    if( records[next_record].is_turn ) {
+        // The game wants more input this turn than was recorded.
+        DebugLog( D_ERROR, DC_ALL ) << "input replay desync: no input left for turn "
+                                    << int( calendar::turn );
+        desyncs++;
+        finish_replay();
+        return input_event();
+    }
+    return records[next_record++].evt;
+}
+
+void input_replay::on_turn_start()
+{
+    const int turn = calendar::turn;
+    if( mode == replay_mode::record ) {
+        if( !header_written ) {
+            write_header();
+        }
+        reseed( turn );
+        record_file << "T " << turn << " " << state_checksum() << "\n";
+        record_file.flush();
+
+    } else if( mode == replay_mode::replay ) {
+        const auto now = std::chrono::steady_clock::now();
+        if( !reports.empty() ) {
+            reports.back().microseconds =
+                std::chrono::duration_cast<std::chrono::microseconds>( now - turn_start ).count();
+        }
+        turn_start = now;
+
+        // Input recorded for the previous turn that the game did not ask for.
+        while( next_record < records.size() && !records[next_record].is_turn ) {
+            next_record++;
+            desyncs++;
+        }
+        if( next_record >= records.size() ) {
+            finish_replay();
+            return;
+        }
+        const session_record &rec = records[next_record++];
+        if( rec.turn != turn ) {
+            DebugLog( D_ERROR, DC_ALL ) << "input replay desync: expected turn " << rec.turn
+                                        << " but game is at turn " << turn;
+            desyncs++;
+        }
+        reseed( rec.turn );
+        reports.push_back( { turn, 0, rec.checksum, state_checksum() } );
+    }
+}
+
+unsigned long input_replay::state_checksum()
+{
+    // FNV-1a over the values that are most likely to diverge after a desync.
+    unsigned long hash = 2166136261u;
+    const auto mix = [&hash]( long value ) {
+        for( int i = 0; i < 4; i++ ) {
+            hash ^= ( value >> ( i * 8 ) ) & 0xff;
+            hash = ( hash * 16777619u ) & 0xffffffffu;
+        }
+    };
+
+    mix( calendar::turn );
+    const player &u = g->u;
+    mix( u.posx() );
+    mix( u.posy() );
+    mix( u.posz() );
+    mix( u.moves );
+    for( const int hp : u.hp_cur ) {
+        mix( hp );
+    }
+    mix( u.get_hunger() );
+    mix( u.get_thirst() );
+    mix( u.get_fatigue() );
+    mix( u.inv.size() );
+
+    const size_t num_zombies = g->num_zombies();
+    mix( num_zombies );
+    for( size_t i = 0; i < num_zombies; i++ ) {
+        const monster &critter = g->zombie( i );
+        mix( critter.posx() );
+        mix( critter.posy() );
+        mix( critter.posz() );
+        mix( critter.get_hp() );
+    }
+    for( const npc *guy : g->active_npc ) {
+        mix( guy->posx() );
+        mix( guy->posy() );
+        mix( guy->posz() );
+        mix( guy->moves );
+    }
+    return hash;
+}
@@ -0,0 +1,65 @@
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include <string>
+
+struct input_event;
+
+/**
+ * Records the input of a play session to a file and replays it later.
+ *
+ * While recording, every event returned by @ref input_manager::get_input_event is written
+ * to the session file. At the start of every turn (see @ref game::do_turn) a turn boundary
+ * with a checksum of the game state is written and the random number generator is reseeded
+ * from the session seed and the turn number.
+ *
+ * The session header references the world and save the session started from, the recorded
+ * session therefore only replays correctly from an unchanged copy of that save.
+ *
+ * When replaying, the recorded events are returned by @ref input_manager::get_input_event
+ * instead of reading from the keyboard. The RNG is reseeded at the same turn boundaries,
+ * the state checksum is compared with the recorded one and the time spent on each turn is
+ * measured. Once all events are used up, a report is written to "<session file>.report"
+ * and the game exits.
+ */
+namespace input_replay
+{
+
+/** Starts recording into the given file, existing content is overwritten. */
+void start_recording( const std::string &path, int seed );
+/**
+ * Loads a recorded session for replay.
+ * @return false if the file could not be read or is not a recorded session.
+ */
+bool start_replay( const std::string &path );
+/** Stops recording or replaying without writing a report. */
+void stop();
+
+bool is_recording();
+bool is_replaying();
+
+/** World the replayed session was recorded in. */
+const std::string &replay_world();
+/** Seed the replayed session was recorded with. */
+int replay_seed();
+
+/** Stores the event in the session file if recording. */
+void record( const input_event &evt );
+/**
+ * Returns the next recorded event while replaying. When the session has been replayed
+ * completely, the report is written and the game exits.
+ */
+input_event next_event();
+
+/**
+ * Marks the start of a new turn, called from @ref game::do_turn.
+ * Reseeds the RNG and writes (when recording) or verifies (when replaying) the state checksum.
+ */
+void on_turn_start();
+
+/** Checksum of the relevant game state, same state yields the same checksum. */
+unsigned long state_checksum();
+
+}
+
+#endif
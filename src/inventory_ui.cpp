@@ -16,6 +16,7 @@
 
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <map>
 #include <numeric>
@@ -120,6 +121,14 @@ const item_category *inventory_entry::get_category_ptr() const {
     return location ? &location->get_category() : nullptr;
 }
 
+const std::string &inventory_entry::get_sort_name() const
+{
+    if( sort_name.empty() && is_item() ) {
+        sort_name = location->tname( 1 );
+    }
+    return sort_name;
+}
+
 bool inventory_column::activatable() const
 {
     return std::any_of( entries.begin(), entries.end(), []( const inventory_entry &e ) {
@@ -154,9 +163,9 @@ inventory_selector_preset::inventory_selector_preset()
     } ) );
 }
 
-bool inventory_selector_preset::sort_compare( const item_location &lhs, const item_location &rhs ) const
+bool inventory_selector_preset::sort_compare( const inventory_entry &lhs, const inventory_entry &rhs ) const
 {
-    return lhs->tname( 1 ).compare( rhs->tname( 1 ) ) < 0; // Simple alphabetic order
+    return lhs.get_sort_name().compare( rhs.get_sort_name() ) < 0; // Simple alphabetic order
 }
 
 nc_color inventory_selector_preset::get_color( const inventory_entry &entry ) const
@@ -398,6 +407,11 @@ size_t inventory_column::page_of( size_t index ) const {
 }
 
 size_t inventory_column::page_of( const inventory_entry &entry ) const {
+    // Entries of this column are found by their address, others have to be looked up
+    const std::less<const inventory_entry *> less;
+    if( !entries.empty() && !less( &entry, entries.data() ) && less( &entry, entries.data() + entries.size() ) ) {
+        return page_of( &entry - entries.data() );
+    }
     return page_of( std::distance( entries.begin(), std::find( entries.begin(), entries.end(), entry ) ) );
 }
 
@@ -459,19 +473,14 @@ void inventory_column::on_input( const inventory_input &input )
 
 void inventory_column::add_entry( const inventory_entry &entry )
 {
-    if( std::find( entries.begin(), entries.end(), entry ) != entries.end() ) {
+    const item_category *category = entry.get_category_ptr();
+    if( !entry_keys.emplace( category, entry.location.get_item() ).second ) {
         debugmsg( "Tried to add a duplicate entry." );
         return;
     }
-    const auto iter = std::find_if( entries.rbegin(), entries.rend(),
-    [ &entry ]( const inventory_entry & cur ) {
-        const item_category *cur_cat = cur.get_category_ptr();
-        const item_category *new_cat = entry.get_category_ptr();
-
-        return cur_cat == new_cat || ( cur_cat != nullptr && new_cat != nullptr
-                                    && cur_cat->sort_rank <= new_cat->sort_rank );
-    } );
-    entries.insert( iter.base(), entry );
+    // The entries are put in order all at once by prepare_paging()
+    category_order.emplace( category, category_order.size() );
+    entries.push_back( entry );
     expand_to_fit( entry );
     paging_is_valid = false;
 }
@@ -498,41 +507,53 @@ void inventory_column::prepare_paging()
     } );
     entries.erase( new_end, entries.end() );
     // Then sort them with respect to categories
-    auto from = entries.begin();
-    while( from != entries.end() ) {
-        auto to = std::next( from );
-        while( to != entries.end() && from->get_category_ptr() == to->get_category_ptr() ) {
-            std::advance( to, 1 );
-        }
-        if( ordered_categories.count( from->get_category_ptr()->id ) == 0 ) {
-            std::sort( from, to, [ this ]( const inventory_entry &lhs, const inventory_entry &rhs ) {
-                if( lhs.is_selectable() != rhs.is_selectable() ) {
-                    return lhs.is_selectable(); // Disabled items always go last
-                }
-                return preset.sort_compare( lhs.location, rhs.location );
-            } );
-        }
-        from = to;
-    }
+    sort_entries();
     // Recover categories according to the new number of entries per page
+    std::vector<inventory_entry> paged_entries;
+    paged_entries.reserve( entries.size() + 2 * ( entries.size() / entries_per_page + category_order.size() ) );
+
     const item_category *current_category = nullptr;
-    for( size_t i = 0; i < entries.size(); ++i ) {
-        if( entries[i].get_category_ptr() == current_category && i % entries_per_page != 0 ) {
-            continue;
+    for( auto &entry : entries ) {
+        while( entry.get_category_ptr() != current_category || paged_entries.size() % entries_per_page == 0 ) {
+            current_category = entry.get_category_ptr();
+            const bool last_on_page = paged_entries.size() % entries_per_page == entries_per_page - 1;
+            paged_entries.push_back( last_on_page
+                ? inventory_entry() // the last item on the page must not be a category
+                : inventory_entry( current_category ) ); // the first item on the page must be a category
+            expand_to_fit( paged_entries.back() );
         }
-        current_category = entries[i].get_category_ptr();
-        const inventory_entry insertion = ( i % entries_per_page == entries_per_page - 1 )
-            ? inventory_entry() // the last item on the page must not be a category
-            : inventory_entry( current_category ); // the first item on the page must be a category
-        entries.insert( entries.begin() + i, insertion );
-        expand_to_fit( insertion );
+        paged_entries.push_back( std::move( entry ) );
     }
+    entries = std::move( paged_entries );
 
     paging_is_valid = true;
     // Select the uppermost possible entry
     select( 0, scroll_direction::FORWARD );
 }
 
+void inventory_column::sort_entries()
+{
+    // Only the item entries are left at this point
+    std::stable_sort( entries.begin(), entries.end(), [ this ]( const inventory_entry &lhs, const inventory_entry &rhs ) {
+        const item_category *lhs_cat = lhs.get_category_ptr();
+        const item_category *rhs_cat = rhs.get_category_ptr();
+
+        if( lhs_cat != rhs_cat ) {
+            if( lhs_cat->sort_rank != rhs_cat->sort_rank ) {
+                return lhs_cat->sort_rank < rhs_cat->sort_rank;
+            }
+            return category_order.at( lhs_cat ) < category_order.at( rhs_cat );
+        }
+        if( ordered_categories.count( lhs_cat->id ) != 0 ) {
+            return false; // Keep the original order
+        }
+        if( lhs.is_selectable() != rhs.is_selectable() ) {
+            return lhs.is_selectable(); // Disabled items always go last
+        }
+        return preset.sort_compare( lhs, rhs );
+    } );
+}
+
 void inventory_column::remove_entry( const inventory_entry &entry )
 {
     const auto iter = std::find( entries.begin(), entries.end(), entry );
@@ -540,6 +561,7 @@ void inventory_column::remove_entry( const inventory_entry &entry )
         debugmsg( "Tried to remove a non-existing entry." );
         return;
     }
+    entry_keys.erase( entry_key( entry.get_category_ptr(), entry.location.get_item() ) );
     entries.erase( iter );
     paging_is_valid = false;
 }
@@ -547,6 +569,8 @@ void inventory_column::remove_entry( const inventory_entry &entry )
 void inventory_column::clear()
 {
     entries.clear();
+    entry_keys.clear();
+    category_order.clear();
     paging_is_valid = false;
     prepare_paging();
 }
@@ -737,16 +761,20 @@ std::vector<std::list<item *>> restack_items( const std::list<item>::const_itera
                                               const std::list<item>::const_iterator &to )
 {
     std::vector<std::list<item *>> res;
+    // Only items of the same type can stack, so only those stacks are compared
+    std::unordered_map<const itype *, std::vector<size_t>> stacks_by_type;
 
     for( auto it = from; it != to; ++it ) {
-        auto match = std::find_if( res.begin(), res.end(),
-            [ &it ]( const std::list<item *> &e ) {
-                return it->stacks_with( *const_cast<item *>( e.back() ) );
+        auto &candidates = stacks_by_type[it->type];
+        auto match = std::find_if( candidates.begin(), candidates.end(),
+            [ &it, &res ]( size_t index ) {
+                return it->stacks_with( *res[index].back() );
             } );
 
-        if( match != res.end() ) {
-            match->push_back( const_cast<item *>( &*it ) );
+        if( match != candidates.end() ) {
+            res[*match].push_back( const_cast<item *>( &*it ) );
         } else {
+            candidates.push_back( res.size() );
             res.emplace_back( 1, const_cast<item *>( &*it ) );
         }
     }
@@ -799,9 +827,13 @@ void inventory_selector::add_item( inventory_column &target_column,
         return;
     }
 
-    items.push_back( location.clone() );
-    inventory_entry entry( items.back(), stack_size, custom_category,
-                           preset.get_denial( location ).empty() );
+    const bool enabled = preset.get_denial( location ).empty();
+    inventory_entry entry( location, stack_size, custom_category, enabled );
+
+    items_count++;
+    if( enabled ) {
+        available_count++;
+    }
 
     target_column.add_entry( entry );
     on_entry_add( entry );
@@ -1219,14 +1251,12 @@ inventory_selector::inventory_selector( const player &u, const inventory_selecto
 
 bool inventory_selector::empty() const
 {
-    return items.empty();
+    return items_count == 0;
 }
 
 bool inventory_selector::has_available_choices() const
 {
-    return std::any_of( items.begin(), items.end(), [ this ]( const item_location &loc ) {
-        return preset.get_denial( loc ).empty();
-    } );
+    return available_count > 0;
 }
 
 inventory_input inventory_selector::get_input()
@@ -3,6 +3,8 @@
 
 #include <limits>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "color.h"
 #include "cursesdef.h"
@@ -54,18 +56,24 @@ class inventory_entry
             custom_invlet( entry.custom_invlet ),
             stack_size( entry.stack_size ),
             custom_category( entry.custom_category ),
-            enabled( entry.enabled ) {}
+            enabled( entry.enabled ),
+            sort_name( entry.sort_name ) {}
 
-        inventory_entry operator=( const inventory_entry &rhs ) {
+        inventory_entry( inventory_entry && ) = default;
+
+        inventory_entry &operator=( const inventory_entry &rhs ) {
             location = rhs.location.clone();
             chosen_count = rhs.chosen_count;
             custom_invlet = rhs.custom_invlet;
             stack_size = rhs.stack_size;
             custom_category = rhs.custom_category;
             enabled = rhs.enabled;
+            sort_name = rhs.sort_name;
             return *this;
         }
 
+        inventory_entry &operator=( inventory_entry && ) = default;
+
         inventory_entry( const item_location &location, const item_category *custom_category = nullptr,
                          bool enabled = true ) :
             inventory_entry( location, location ? 1 : 0, custom_category, enabled ) {}
@@ -114,11 +122,14 @@ class inventory_entry
         const item_category *get_category_ptr() const;
         long get_invlet() const;
         nc_color get_invlet_color() const;
+        /** Name used for sorting, evaluated once per entry. */
+        const std::string &get_sort_name() const;
 
     private:
         size_t stack_size;
         const item_category *custom_category;
         bool enabled = true;
+        mutable std::string sort_name;
 
 };
 
@@ -139,8 +150,8 @@ class inventory_selector_preset
         virtual std::string get_denial( const item_location & ) const {
             return std::string();
         }
-        /** Whether the first item is considered to go before the second. */
-        virtual bool sort_compare( const item_location &lhs, const item_location &rhs ) const;
+        /** Whether the first entry is considered to go before the second. */
+        virtual bool sort_compare( const inventory_entry &lhs, const inventory_entry &rhs ) const;
         /** Color that will be used to display the entry string. */
         virtual nc_color get_color( const inventory_entry &entry ) const;
 
@@ -316,6 +327,8 @@ class inventory_column
         size_t get_cells_width() const;
 
         std::string get_entry_denial( const inventory_entry &entry ) const;
+        /** Reorders the item entries by category and @ref inventory_selector_preset::sort_compare */
+        void sort_entries();
 
         const inventory_selector_preset &preset;
 
@@ -345,7 +358,20 @@ class inventory_column
             }
         };
 
+        /** Identifies an item entry the same way as @ref inventory_entry::operator== does. */
+        using entry_key = std::pair<const item_category *, const item *>;
+
+        struct entry_key_hash {
+            size_t operator()( const entry_key &key ) const {
+                return std::hash<const void *>()( key.first ) ^ ( std::hash<const void *>()( key.second ) << 1 );
+            }
+        };
+
         std::vector<cell_t> cells;
+        /** Keys of all item entries, used to reject duplicates */
+        std::unordered_set<entry_key, entry_key_hash> entry_keys;
+        /** Order in which the categories were added, it breaks ties between equal sort ranks */
+        std::unordered_map<const item_category *, size_t> category_order;
 
         /** @return Number of visible cells */
         size_t visible_cells() const;
@@ -505,7 +531,8 @@ class inventory_selector
     private:
         WINDOW_PTR w_inv;
 
-        std::list<item_location> items;
+        size_t items_count = 0;              // Number of items added to the columns
+        size_t available_count = 0;          // Number of items that can be selected
         std::vector<inventory_column *> columns;
 
         std::string title;
@@ -40,6 +40,7 @@
 #include "input.h"
 #include "fault.h"
 #include "vehicle_selector.h"
+#include "memory_usage.h"
 
 #include <cmath> // floor
 #include <sstream>
@@ -108,6 +109,23 @@ static const itype *nullitem()
 
 const long item::INFINITE_CHARGES = std::numeric_limits<long>::max();
 
+static long last_item_uid = 0;
+
+long item::new_uid()
+{
+    return ++last_item_uid;
+}
+
+long item::last_uid()
+{
+    return last_item_uid;
+}
+
+void item::reserve_uid( const long uid )
+{
+    last_item_uid = std::max( last_item_uid, uid );
+}
+
 item::item()
 {
     type = nullitem();
@@ -115,6 +133,7 @@ item::item()
 
 item::item( const itype *type, int turn, long qty ) : type( type )
 {
+    uid = new_uid();
     bday = turn >= 0 ? turn : int( calendar::turn );
     corpse = typeId() == "corpse" ? &mtype_id::NULL_ID.obj() : nullptr;
     item_counter = type->countdown_interval;
@@ -356,6 +375,7 @@ item item::split( long qty )
         return item();
     }
     item res = *this;
+    res.uid = new_uid();
     res.charges = qty;
     charges -= qty;
     return res;
@@ -2072,11 +2092,13 @@ void item::on_wear( Character &p )
     }
 
     p.on_item_wear( *this );
+    p.invalidate_artifact_cache();
 }
 
 void item::on_takeoff( Character &p )
 {
     p.on_item_takeoff( *this );
+    p.invalidate_artifact_cache();
 
     if (is_sided()) {
         set_side(BOTH);
@@ -2085,6 +2107,8 @@ void item::on_takeoff( Character &p )
 
 void item::on_wield( player &p, int mv )
 {
+    p.invalidate_artifact_cache();
+
     // TODO: artifacts currently only work with the player character
     if( &p == &g->u && type->artifact ) {
         g->add_artifact_messages( type->artifact->effects_wielded );
@@ -2515,6 +2539,27 @@ units::volume item::base_volume() const
     return type->volume;
 }
 
+size_t item::estimate_memory_usage() const
+{
+    using namespace memory_usage;
+    size_t result = sizeof( item );
+    result += heap_size( item_vars );
+    result += heap_size( corpse_name );
+    result += node_size( techniques ) + node_size( faults ) + node_size( item_tags );
+    for( const auto &tag : item_tags ) {
+        result += heap_size( tag );
+    }
+    result += contents.size() * list_node_size;
+    for( const auto &e : contents ) {
+        result += e.estimate_memory_usage();
+    }
+    result += ( components.capacity() - components.size() ) * sizeof( item );
+    for( const auto &e : components ) {
+        result += e.estimate_memory_usage();
+    }
+    return result;
+}
+
 units::volume item::volume( bool integral ) const
 {
     if( is_null() ) {
@@ -349,6 +349,9 @@ class item : public JsonSerializer, public JsonDeserializer, public visitable<it
      * @param integral if true return effective volume if item was integrated into another */
     units::volume volume( bool integral = false ) const;
 
+    /** Estimated memory used by this item and its contents, see memory_usage.h */
+    size_t estimate_memory_usage() const;
+
     /** Simplified, faster volume check for when processing time is important and exact volume is not. */
     units::volume base_volume() const;
 
@@ -1531,12 +1534,25 @@ public:
 public:
     static const long INFINITE_CHARGES;
 
+    /** Returns a value for @ref uid that no other item of the current game has. */
+    static long new_uid();
+    /** The largest @ref uid handed out or loaded so far. */
+    static long last_uid();
+    /** Makes @ref new_uid return values larger than @p uid, used when loading. */
+    static void reserve_uid( long uid );
+
      char invlet = 0;      // Inventory letter
      long charges;
      bool active = false; // If true, it has active effects to be processed
 
     int burnt = 0;           // How badly we're burnt
     int bday;                // The turn on which it was created
+    /**
+     * Identifies the item in saves, see @ref item_location. Assigned when the item is
+     * created and kept by copies, so moving an item anywhere keeps it. Identical copies
+     * (e.g. of spawned stacks) share it, which is fine as they are interchangeable.
+     */
+    long uid = 0;
     int poison = 0;          // How badly poisoned is it?
     int frequency = 0;       // Radio frequency
     int note = 0;            // Associated dynamic text snippet.
@@ -211,6 +211,14 @@ class Item_factory
             m_runtimes[ def.id ].reset( new itype( def ) );
         }
 
+        /**
+         * Removes the item types that were added after the data was loaded (artifacts and
+         * placeholders for unknown ids), leaving only those loaded from json.
+         */
+        void clear_runtime_types() {
+            m_runtimes.clear();
+        }
+
         /**
          * Check if an iuse is known to the Item_factory.
          * @param type Iuse type id.
@@ -19,19 +19,20 @@
 #include <algorithm>
 
 template <typename T>
-static int find_index( const T &sel, const item *obj )
+static item *retrieve_uid( const T &sel, long uid )
 {
-    int idx = -1;
-    sel.visit_items( [&idx, &obj]( const item * e ) {
-        idx++;
-        if( e == obj ) {
+    item *obj = nullptr;
+    sel.visit_items( [uid, &obj]( const item * e ) {
+        if( e->uid == uid ) {
+            obj = const_cast<item *>( e );
             return VisitResponse::ABORT;
         }
         return VisitResponse::NEXT;
     } );
-    return idx;
+    return obj;
 }
 
+/** Locations saved before items had an uid refer to the position in the visiting order. */
 template <typename T>
 static item *retrieve_index( const T &sel, int idx )
 {
@@ -46,6 +47,12 @@ static item *retrieve_index( const T &sel, int idx )
     return obj;
 }
 
+template <typename T>
+static item *retrieve( const T &sel, long uid, int idx )
+{
+    return uid > 0 ? retrieve_uid( sel, uid ) : retrieve_index( sel, idx );
+}
+
 class item_location::impl
 {
     public:
@@ -56,7 +63,7 @@ class item_location::impl
 
         impl() = default;
         impl( item *what ) : what( what ) {}
-        impl( int idx ) : idx( idx ) {}
+        impl( long uid, int idx ) : uid( uid ), idx( idx ), pending( true ) {}
 
         virtual ~impl() = default;
 
@@ -88,21 +95,30 @@ class item_location::impl
 
         virtual void serialize( JsonOut &js ) const = 0;
 
-        virtual item *unpack( int ) const {
+        /** Finds the item by its @ref item::uid or, for legacy saves, its visiting order. */
+        virtual item *unpack( long, int ) const {
             return nullptr;
         }
 
         item *target() const {
-            if( idx >= 0 ) {
-                what = unpack( idx );
-                idx = -1;
+            if( pending ) {
+                what = unpack( uid, idx );
+                pending = false;
             }
             return what;
         }
 
+        /** The uid to save, 0 if this does not point to an item. */
+        long target_uid() const {
+            return target() ? target()->uid : 0;
+        }
+
     private:
         mutable item *what = nullptr;
-        mutable int idx = -1;
+        long uid = 0;
+        int idx = -1;
+        /** Whether @ref what still needs to be looked up by @ref unpack. */
+        mutable bool pending = false;
 };
 
 class item_location::impl::nowhere : public item_location::impl
@@ -122,7 +138,7 @@ class item_location::impl::item_on_map : public item_location::impl
 
     public:
         item_on_map( const map_cursor &cur, item *which ) : impl( which ), cur( cur ) {}
-        item_on_map( const map_cursor &cur, int idx ) : impl( idx ), cur( cur ) {}
+        item_on_map( const map_cursor &cur, long uid, int idx ) : impl( uid, idx ), cur( cur ) {}
 
         bool valid() const override {
             return target() && cur.has_item( *target() );
@@ -132,12 +148,12 @@ class item_location::impl::item_on_map : public item_location::impl
             js.start_object();
             js.member( "type", "map" );
             js.member( "pos", position() );
-            js.member( "idx", find_index( cur, target() ) );
+            js.member( "uid", target_uid() );
             js.end_object();
         }
 
-        item *unpack( int idx ) const override {
-            return retrieve_index( cur, idx );
+        item *unpack( long uid, int idx ) const override {
+            return retrieve( cur, uid, idx );
         }
 
         type where() const override {
@@ -201,7 +217,7 @@ class item_location::impl::item_on_person : public item_location::impl
 
     public:
         item_on_person( Character &who, item *which ) : impl( which ), who( who ) {}
-        item_on_person( Character &who, int idx ) : impl( idx ), who( who ) {}
+        item_on_person( Character &who, long uid, int idx ) : impl( uid, idx ), who( who ) {}
 
         bool valid() const override {
             return target() && who.has_item( *target() );
@@ -210,12 +226,12 @@ class item_location::impl::item_on_person : public item_location::impl
         void serialize( JsonOut &js ) const override {
             js.start_object();
             js.member( "type", "character" );
-            js.member( "idx", find_index( who, target() ) );
+            js.member( "uid", target_uid() );
             js.end_object();
         }
 
-        item *unpack( int idx ) const override {
-            return retrieve_index( who, idx );
+        item *unpack( long uid, int idx ) const override {
+            return retrieve( who, uid, idx );
         }
 
         type where() const override {
@@ -329,7 +345,7 @@ class item_location::impl::item_on_vehicle : public item_location::impl
 
     public:
         item_on_vehicle( const vehicle_cursor &cur, item *which ) : impl( which ), cur( cur ) {}
-        item_on_vehicle( const vehicle_cursor &cur, int idx ) : impl( idx ), cur( cur ) {}
+        item_on_vehicle( const vehicle_cursor &cur, long uid, int idx ) : impl( uid, idx ), cur( cur ) {}
 
         bool valid() const override {
             if( !target() ) {
@@ -350,13 +366,16 @@ class item_location::impl::item_on_vehicle : public item_location::impl
             js.member( "pos", position() );
             js.member( "part", cur.part );
             if( target() != &cur.veh.parts[ cur.part ].base ) {
-                js.member( "idx", find_index( cur, target() ) );
+                js.member( "uid", target_uid() );
             }
             js.end_object();
         }
 
-        item *unpack( int idx ) const override {
-            return idx >= 0 ? retrieve_index( cur, idx ) : &cur.veh.parts[ cur.part ].base;
+        item *unpack( long uid, int idx ) const override {
+            if( uid <= 0 && idx < 0 ) {
+                return &cur.veh.parts[ cur.part ].base;
+            }
+            return retrieve( cur, uid, idx );
         }
 
         type where() const override {
@@ -482,23 +501,25 @@ void item_location::deserialize( JsonIn &js )
     auto obj = js.get_object();
     auto type = obj.get_string( "type" );
 
+    long uid = 0;
     int idx = -1;
     tripoint pos = tripoint_min;
 
+    obj.read( "uid", uid );
     obj.read( "idx", idx );
     obj.read( "pos", pos );
 
     if( type == "character" ) {
-        ptr.reset( new impl::item_on_person( g->u, idx ) );
+        ptr.reset( new impl::item_on_person( g->u, uid, idx ) );
 
     } else if( type == "map" ) {
-        ptr.reset( new impl::item_on_map( pos, idx ) );
+        ptr.reset( new impl::item_on_map( pos, uid, idx ) );
 
     } else if( type == "vehicle" ) {
         auto *veh = g->m.veh_at( pos );
         int part = obj.get_int( "part" );
         if( veh && part >= 0 && part < int( veh->parts.size() ) ) {
-            ptr.reset( new impl::item_on_vehicle( vehicle_cursor( *veh, part ), idx ) );
+            ptr.reset( new impl::item_on_vehicle( vehicle_cursor( *veh, part ), uid, idx ) );
         }
     }
 }
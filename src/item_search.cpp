@@ -3,6 +3,7 @@
 #include "item_search.h"
 #include "cata_utility.h"
 #include "output.h"
+#include "catacharset.h"
 
 #include <algorithm>
 
@@ -69,8 +70,9 @@ item_filter_from_string( std::string filter )
     }
     bool exclude = filter[0] == '-';
     if( exclude ) {
-        return [filter]( const item &i ) {
-            return !item_filter_from_string( filter.substr( 1 ) )( i );
+        const auto included = item_filter_from_string( filter.substr( 1 ) );
+        return [included]( const item &i ) {
+            return !included( i );
         };
     }
     size_t colon;
@@ -81,30 +83,35 @@ item_filter_from_string( std::string filter )
             filter = filter.substr( colon + 1 );
         }
     }
+    // Only the texts of the items still need to be folded for each item
+    const std::string folded = fold_case( filter );
     switch( flag ) {
         case 'c'://category
-            return [filter]( const item & i ) {
-                return lcmatch( i.get_category().name, filter );
+            return [folded]( const item & i ) {
+                return lcmatch_folded( i.get_category().name, folded );
             };
             break;
         case 'm'://material
-            return [filter]( const item & i ) {
+            return [folded]( const item & i ) {
                 return std::any_of( i.made_of().begin(), i.made_of().end(),
-                                    [&filter]( const material_id &mat ) {
-                    return lcmatch( mat->name(), filter );
+                                    [&folded]( const material_id &mat ) {
+                    return lcmatch_folded( mat->name(), folded );
                 } );
             };
             break;
         case 'b'://both
-            return [filter]( const item & i ) {
-                auto pair = get_both( filter );
-                return item_filter_from_string( pair.first )( i )
-                       && item_filter_from_string( pair.second )( i );
-            };
+            {
+                const auto pair = get_both( filter );
+                const auto first = item_filter_from_string( pair.first );
+                const auto second = item_filter_from_string( pair.second );
+                return [first, second]( const item & i ) {
+                    return first( i ) && second( i );
+                };
+            }
             break;
         default://by name
-            return [filter]( const item & a ) {
-                return lcmatch( a.tname(), filter );
+            return [folded]( const item & a ) {
+                return lcmatch_folded( a.tname(), folded );
             };
             break;
     }
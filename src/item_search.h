@@ -4,7 +4,8 @@
 #include <functional>
 class item;
 /**
- * Get a function that returns true if the item matches the query.
+ * Get a function that returns true if the item matches the query. The query is only parsed
+ * here, so reuse the function when filtering many items.
  */
 std::function<bool(const item&)> item_filter_from_string(std::string);
 #endif
@@ -1,6 +1,7 @@
 #include "json.h"
 
 #include <cmath> // pow
+#include <cstdio> // snprintf
 #include <cstdlib> // strtoul
 #include <cstring> // strcmp
 #include <fstream>
@@ -1574,18 +1575,40 @@ JsonOut::JsonOut( std::ostream &s, bool pretty ) : stream( &s ), pretty_print( p
 
     // automatically stringify bool to "true" or "false"
     stream->setf( std::ios_base::boolalpha );
+
+    // numbers are formatted by JsonOut itself, it only needs the precision of the stream
+    float_precision = stream->precision();
+}
+
+JsonOut::~JsonOut()
+{
+    flush();
+}
+
+void JsonOut::flush()
+{
+    if( !buffer.empty() ) {
+        stream->write( buffer.data(), buffer.size() );
+        buffer.clear();
+    }
+}
+
+void JsonOut::write_line_break()
+{
+    buffer += '\n';
+    flush_if_full();
 }
 
 void JsonOut::write_indent()
 {
-    std::fill_n( std::ostream_iterator<char>( *stream ), indent_level * 2, ' ' );
+    buffer.append( indent_level * 2, ' ' );
 }
 
 void JsonOut::write_separator()
 {
-    stream->put(',');
+    buffer += ',';
     if (pretty_print) {
-        stream->put('\n');
+        buffer += '\n';
         write_indent();
     }
     need_separator = false;
@@ -1594,9 +1617,9 @@ void JsonOut::write_separator()
 void JsonOut::write_member_separator()
 {
     if (pretty_print) {
-        stream->write( ": ", 2 );
+        buffer.append( ": ", 2 );
     } else {
-        stream->put(':');
+        buffer += ':';
     }
     need_separator = false;
 }
@@ -1606,10 +1629,10 @@ void JsonOut::start_object()
     if (need_separator) {
         write_separator();
     }
-    stream->put('{');
+    buffer += '{';
     if (pretty_print) {
         indent_level += 1;
-        stream->put('\n');
+        buffer += '\n';
         write_indent();
     }
     need_separator = false;
@@ -1619,11 +1642,12 @@ void JsonOut::end_object()
 {
     if (pretty_print) {
         indent_level -= 1;
-        stream->put('\n');
+        buffer += '\n';
         write_indent();
     }
-    stream->put('}');
+    buffer += '}';
     need_separator = true;
+    flush_if_full();
 }
 
 void JsonOut::start_array()
@@ -1631,10 +1655,10 @@ void JsonOut::start_array()
     if (need_separator) {
         write_separator();
     }
-    stream->put('[');
+    buffer += '[';
     if (pretty_print) {
         indent_level += 1;
-        stream->put('\n');
+        buffer += '\n';
         write_indent();
     }
     need_separator = false;
@@ -1644,11 +1668,12 @@ void JsonOut::end_array()
 {
     if (pretty_print) {
         indent_level -= 1;
-        stream->put('\n');
+        buffer += '\n';
         write_indent();
     }
-    stream->put(']');
+    buffer += ']';
     need_separator = true;
+    flush_if_full();
 }
 
 void JsonOut::write_null()
@@ -1656,69 +1681,144 @@ void JsonOut::write_null()
     if (need_separator) {
         write_separator();
     }
-    stream->write("null", 4);
+    buffer.append( "null", 4 );
     need_separator = true;
 }
 
-void JsonOut::write( const std::string &val )
+void JsonOut::write_value( const bool val )
+{
+    if( val ) {
+        buffer.append( "true", 4 );
+    } else {
+        buffer.append( "false", 5 );
+    }
+}
+
+void JsonOut::write_value( const long long val )
+{
+    if( val < 0 ) {
+        buffer += '-';
+        // negate as unsigned, -LLONG_MIN does not fit into long long
+        write_value( 0ull - static_cast<unsigned long long>( val ) );
+    } else {
+        write_value( static_cast<unsigned long long>( val ) );
+    }
+}
+
+void JsonOut::write_value( unsigned long long val )
+{
+    char digits[24];
+    char *const end = digits + sizeof( digits );
+    char *first = end;
+    do {
+        *--first = '0' + val % 10;
+        val /= 10;
+    } while( val != 0 );
+    buffer.append( first, end - first );
+}
+
+void JsonOut::write_value( const double val )
+{
+    // Same format the stream uses with showpoint and fixed.
+    char formatted[64];
+    const int len = snprintf( formatted, sizeof( formatted ), "%#.*f", float_precision, val );
+    if( len < static_cast<int>( sizeof( formatted ) ) ) {
+        write_float( formatted, len );
+    } else {
+        std::vector<char> large( len + 1 );
+        snprintf( large.data(), large.size(), "%#.*f", float_precision, val );
+        write_float( large.data(), len );
+    }
+}
+
+void JsonOut::write_value( const long double val )
+{
+    char formatted[64];
+    const int len = snprintf( formatted, sizeof( formatted ), "%#.*Lf", float_precision, val );
+    if( len < static_cast<int>( sizeof( formatted ) ) ) {
+        write_float( formatted, len );
+    } else {
+        std::vector<char> large( len + 1 );
+        snprintf( large.data(), large.size(), "%#.*Lf", float_precision, val );
+        write_float( large.data(), len );
+    }
+}
+
+void JsonOut::write_float( const char *formatted, const size_t len )
+{
+    // Not checked with std::isfinite, which is unreliable with -ffast-math.
+    const size_t sign = formatted[0] == '-' ? 1 : 0;
+    if( sign >= len || !isdigit( formatted[sign] ) ) {
+        // inf or nan
+        buffer.append( formatted, len );
+        return;
+    }
+    // snprintf uses the decimal point of the global locale, the stream uses the classic one.
+    size_t point = 0;
+    while( point < len && ( isdigit( formatted[point] ) || formatted[point] == '-' ) ) {
+        point++;
+    }
+    size_t fraction = point;
+    while( fraction < len && !isdigit( formatted[fraction] ) ) {
+        fraction++;
+    }
+    buffer.append( formatted, point );
+    buffer += '.';
+    buffer.append( formatted + fraction, len - fraction );
+}
+
+void JsonOut::write_string( const char *val, const size_t len )
 {
     if (need_separator) {
         write_separator();
     }
-    unsigned char ch;
-    stream->put('"');
-    for( const auto &i : val ) {
-        ch = i;
+    buffer += '"';
+    // Characters that need no escaping are copied in runs.
+    size_t run = 0;
+    for( size_t i = 0; i < len; i++ ) {
+        const unsigned char ch = val[i];
+        if( ch >= 0x20 && ch != '"' && ch != '\\' ) {
+            continue;
+        }
+        buffer.append( val + run, i - run );
+        run = i + 1;
         if (ch == '"') {
-            stream->write("\\\"", 2);
+            buffer.append( "\\\"", 2 );
         } else if (ch == '\\') {
-            stream->write("\\\\", 2);
-        } else if (ch == '/') {
-            // don't technically need to escape this
-            stream->put('/');
+            buffer.append( "\\\\", 2 );
         } else if (ch == '\b') {
-            stream->write("\\b", 2);
+            buffer.append( "\\b", 2 );
         } else if (ch == '\f') {
-            stream->write("\\f", 2);
+            buffer.append( "\\f", 2 );
         } else if (ch == '\n') {
-            stream->write("\\n", 2);
+            buffer.append( "\\n", 2 );
         } else if (ch == '\r') {
-            stream->write("\\r", 2);
+            buffer.append( "\\r", 2 );
         } else if (ch == '\t') {
-            stream->write("\\t", 2);
-        } else if (ch < 0x20) {
+            buffer.append( "\\t", 2 );
+        } else {
             // convert to "\uxxxx" unicode escape
-            stream->write("\\u00", 4);
-            stream->put((ch < 0x10) ? '0' : '1');
+            buffer.append( "\\u00", 4 );
+            buffer += (ch < 0x10) ? '0' : '1';
             char remainder = ch & 0x0F;
             if (remainder < 0x0A) {
-                stream->put('0' + remainder);
+                buffer += '0' + remainder;
             } else {
-                stream->put('A' + (remainder - 0x0A));
+                buffer += 'A' + (remainder - 0x0A);
             }
-        } else {
-            stream->put(ch);
         }
     }
-    stream->put('"');
+    buffer.append( val + run, len - run );
+    buffer += '"';
     need_separator = true;
+    flush_if_full();
 }
 
 template<size_t N>
 void JsonOut::write(const std::bitset<N> &b)
 {
-    if (need_separator) {
-        write_separator();
-    }
-    std::string converted = b.to_string();
-    unsigned char ch;
-    stream->put('"');
-    for (auto &i : converted) {
-        ch = i;
-        stream->put(ch);
-    }
-    stream->put('"');
-    need_separator = true;
+    const std::string converted = b.to_string();
+    write_string( converted.data(), converted.size() );
 }
 
 void JsonOut::write(const JsonSerializer &thing)
@@ -1728,6 +1828,7 @@ void JsonOut::write(const JsonSerializer &thing)
     }
     thing.serialize(*this);
     need_separator = true;
+    flush_if_full();
 }
 
 void JsonOut::member(const std::string &name)
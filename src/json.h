@@ -10,6 +10,7 @@
 #include <map>
 #include <set>
 #include <stdexcept>
+#include <cstring>
 
 /* Cataclysm-DDA homegrown JSON tools
  * copyright CC-BY-SA-3.0 2013 CleverRaven
@@ -413,6 +414,10 @@ class JsonIn
  * and the constructor also has an option for crude pretty-printing,
  * which inserts newlines and whitespace liberally, if turned on.
  *
+ * Output is collected in an internal buffer and written to the stream
+ * in large blocks. The buffer is written when the JsonOut is destroyed,
+ * call flush() before writing to the stream directly while it is alive.
+ *
  * Basic containers such as maps, sets and vectors,
  * as well as anything inheriting the JsonSerializer interface,
  * can be serialized automatically by write() and member().
@@ -421,12 +426,55 @@ class JsonOut
 {
     private:
         std::ostream *stream;
+        /** Output not yet written to the stream. */
+        std::string buffer;
         bool pretty_print;
         bool need_separator = false;
         int indent_level = 0;
+        /** Digits after the decimal point, taken from the stream. */
+        int float_precision;
+
+        /** Buffer size at which it is written to the stream. */
+        static constexpr size_t flush_size = 64 * 1024;
+
+        void flush_if_full() {
+            if( buffer.size() >= flush_size ) {
+                flush();
+            }
+        }
+
+        // number formatting, identical to the output of the stream
+        void write_value( bool val );
+        void write_value( int val ) {
+            write_value( static_cast<long long>( val ) );
+        }
+        void write_value( unsigned int val ) {
+            write_value( static_cast<unsigned long long>( val ) );
+        }
+        void write_value( long val ) {
+            write_value( static_cast<long long>( val ) );
+        }
+        void write_value( unsigned long val ) {
+            write_value( static_cast<unsigned long long>( val ) );
+        }
+        void write_value( long long val );
+        void write_value( unsigned long long val );
+        void write_value( double val );
+        void write_value( long double val );
+        void write_float( const char *formatted, size_t len );
+
+        void write_string( const char *val, size_t len );
 
     public:
         JsonOut(std::ostream &stream, bool pretty_print = false);
+        ~JsonOut();
+        JsonOut( const JsonOut & ) = delete;
+        JsonOut &operator=( const JsonOut & ) = delete;
+
+        /** Writes the buffered output to the stream. */
+        void flush();
+        /** Writes a line break outside of the JSON structure, only valid between values. */
+        void write_line_break();
 
         // punctuation
         void write_indent();
@@ -445,8 +493,9 @@ class JsonOut
             if( need_separator ) {
                 write_separator();
             }
-            *stream << val;
+            write_value( val );
             need_separator = true;
+            flush_if_full();
         }
 
         template <typename T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0>
@@ -455,8 +504,12 @@ class JsonOut
         }
 
         // strings need escaping and quoting
-        void write( const std::string &val );
-        void write( const char *val ) { write( std::string( val ) ); }
+        void write( const std::string &val ) {
+            write_string( val.data(), val.size() );
+        }
+        void write( const char *val ) {
+            write_string( val, strlen( val ) );
+        }
 
         // char should always be written as an unquoted numeral
         void write(          char val ) { write( static_cast<int>( val ) ); }
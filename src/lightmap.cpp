@@ -46,6 +46,62 @@ void map::add_light_from_items( const tripoint &p, std::list<item>::iterator beg
     }
 }
 
+float map::tile_transparency( const submap &sm, const int sx, const int sy,
+                              const bool outside ) const
+{
+    if( !( sm.ter[sx][sy].obj().transparent && sm.frn[sx][sy].obj().transparent ) ) {
+        return LIGHT_TRANSPARENCY_SOLID;
+    }
+
+    // Default to just barely not transparent.
+    float value = LIGHT_TRANSPARENCY_OPEN_AIR;
+    if( outside ) {
+        value *= weather_data(g->weather).sight_penalty;
+    }
+
+    for( auto const &fld : sm.fld[sx][sy] ) {
+        const field_entry &cur = fld.second;
+        const field_id type = cur.getFieldType();
+        const int density = cur.getFieldDensity();
+
+        if( fieldlist[type].transparent[density - 1] ) {
+            continue;
+        }
+
+        // Fields are either transparent or not, however we want some to be translucent
+        switch (type) {
+        case fd_cigsmoke:
+        case fd_weedsmoke:
+        case fd_cracksmoke:
+        case fd_methsmoke:
+        case fd_relax_gas:
+            value *= 5;
+            break;
+        case fd_smoke:
+        case fd_incendiary:
+        case fd_toxic_gas:
+        case fd_tear_gas:
+            if (density == 3) {
+                value = LIGHT_TRANSPARENCY_SOLID;
+            } else if (density == 2) {
+                value *= 10;
+            }
+            break;
+        case fd_nuke_gas:
+            value *= 10;
+            break;
+        case fd_fire:
+            value *= 1.0 - ( density * 0.3 );
+            break;
+        default:
+            value = LIGHT_TRANSPARENCY_SOLID;
+            break;
+        }
+        // TODO: [lightmap] Have glass reduce light as well
+    }
+    return value;
+}
+
 // TODO Consider making this just clear the cache and dynamically fill it in as trans() is called
 void map::build_transparency_cache( const int zlev )
 {
@@ -57,7 +113,6 @@ void map::build_transparency_cache( const int zlev )
         return;
     }
 
-    // Default to just barely not transparent.
     std::uninitialized_fill_n(
         &transparency_cache[0][0], MAPSIZE*SEEX * MAPSIZE*SEEY, LIGHT_TRANSPARENCY_OPEN_AIR);
 
@@ -70,64 +125,53 @@ void map::build_transparency_cache( const int zlev )
                 for( int sy = 0; sy < SEEY; ++sy ) {
                     const int x = sx + smx * SEEX;
                     const int y = sy + smy * SEEY;
+                    transparency_cache[x][y] = tile_transparency( *cur_submap, sx, sy, outside_cache[x][y] );
+                }
+            }
+        }
+    }
+    map_cache.transparency_cache_dirty = false;
+}
 
-                    auto &value = transparency_cache[x][y];
-
-                    if( !(cur_submap->ter[sx][sy].obj().transparent &&
-                          cur_submap->frn[sx][sy].obj().transparent) ) {
-                        value = LIGHT_TRANSPARENCY_SOLID;
-                        continue;
-                    }
-
-                    if( outside_cache[x][y] ) {
-                        value *= weather_data(g->weather).sight_penalty;
-                    }
-
-                    for( auto const &fld : cur_submap->fld[sx][sy] ) {
-                        const field_entry &cur = fld.second;
-                        const field_id type = cur.getFieldType();
-                        const int density = cur.getFieldDensity();
-
-                        if( fieldlist[type].transparent[density - 1] ) {
-                            continue;
-                        }
+bool map::update_transparency_cache( const int smx, const int smy, const int zlev )
+{
+    bool changed = false;
+    for( int sx = 0; sx < SEEX; ++sx ) {
+        for( int sy = 0; sy < SEEY; ++sy ) {
+            changed |= update_transparency_cache( tripoint( sx + smx * SEEX, sy + smy * SEEY, zlev ) );
+        }
+    }
+    return changed;
+}
 
-                        // Fields are either transparent or not, however we want some to be translucent
-                        switch (type) {
-                        case fd_cigsmoke:
-                        case fd_weedsmoke:
-                        case fd_cracksmoke:
-                        case fd_methsmoke:
-                        case fd_relax_gas:
-                            value *= 5;
-                            break;
-                        case fd_smoke:
-                        case fd_incendiary:
-                        case fd_toxic_gas:
-                        case fd_tear_gas:
-                            if (density == 3) {
-                                value = LIGHT_TRANSPARENCY_SOLID;
-                            } else if (density == 2) {
-                                value *= 10;
-                            }
-                            break;
-                        case fd_nuke_gas:
-                            value *= 10;
-                            break;
-                        case fd_fire:
-                            value *= 1.0 - ( density * 0.3 );
-                            break;
-                        default:
-                            value = LIGHT_TRANSPARENCY_SOLID;
-                            break;
-                        }
-                        // TODO: [lightmap] Have glass reduce light as well
-                    }
+bool map::update_transparency_cache( const tripoint &p )
+{
+    auto &map_cache = get_cache( p.z );
+    if( map_cache.transparency_cache_dirty || map_cache.outside_cache_dirty ) {
+        return false;
+    }
+    int lx, ly;
+    const submap &cur_submap = *get_submap_at( p, lx, ly );
+    float value = tile_transparency( cur_submap, lx, ly, map_cache.outside_cache[p.x][p.y] );
+    int part;
+    const vehicle *veh = map_cache.veh_exists_at[p.x][p.y] ? veh_at_internal( p, part ) : nullptr;
+    if( veh != nullptr ) {
+        // Same as the vehicle pass of build_map_cache
+        const point &mount = veh->parts[part].mount;
+        for( const int vp : veh->parts_at_relative( mount.x, mount.y ) ) {
+            if( veh->part_flag( vp, VPFLAG_OPAQUE ) && !veh->parts[vp].is_broken() ) {
+                const int dpart = veh->part_with_feature( vp, VPFLAG_OPENABLE );
+                if( dpart < 0 || !veh->parts[dpart].open ) {
+                    value = LIGHT_TRANSPARENCY_SOLID;
                 }
             }
         }
     }
-    map_cache.transparency_cache_dirty = false;
+    if( value == map_cache.transparency_cache[p.x][p.y] ) {
+        return false;
+    }
+    map_cache.transparency_cache[p.x][p.y] = value;
+    return true;
 }
 
 void map::apply_character_light( player &p )
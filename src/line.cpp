@@ -7,182 +7,77 @@
 
 #define SGN(a) (((a)<0) ? -1 : (((a)>0) ? 1 : 0))
 
-void bresenham( const int x1, const int y1, const int x2, const int y2, int t,
-                const std::function<bool(const point &)> &interact )
+bresenham_state::bresenham_state( const tripoint &from, const tripoint &to, int t, int t2 )
+    : cur( from ), t( t ), t2( t2 )
 {
     // The slope components.
-    const int dx = x2 - x1;
-    const int dy = y2 - y1;
-    // Signs of slope values.
-    const int sx = (dx == 0) ? 0 : SGN(dx);
-    const int sy = (dy == 0) ? 0 : SGN(dy);
-    // Absolute values of slopes x2 to avoid rounding errors.
-    const int ax = abs(dx) * 2;
-    const int ay = abs(dy) * 2;
-
-    point cur(x1, y1);
-
-    if( ax == ay ) {
-        while( cur.x != x2 ) {
-            cur.y += sy;
-            cur.x += sx;
-            if( !interact( cur ) ) {
-                break;
-            }
-        }
-    } else if( ax > ay ) {
-        while( cur.x != x2 ) {
-            if( t > 0 ) {
-                cur.y += sy;
-                t -= ax;
-            }
-            cur.x += sx;
-            t += ay;
-            if( !interact( cur ) ) {
-                break;
-            }
-        }
-    } else {
-        while( cur.y != y2 ) {
-            if( t > 0 ) {
-                cur.x += sx;
-                t -= ay;
-            }
-            cur.y += sy;
-            t += ax;
-            if( !interact( cur ) ) {
-                break;
-            }
-        }
-    }
-}
-
-void bresenham( const tripoint &loc1, const tripoint &loc2, int t, int t2,
-                const std::function<bool(const tripoint &)> &interact )
-{
-    // The slope components.
-    const int dx = loc2.x - loc1.x;
-    const int dy = loc2.y - loc1.y;
-    const int dz = loc2.z - loc1.z;
+    const int dx = to.x - from.x;
+    const int dy = to.y - from.y;
+    const int dz = to.z - from.z;
     // The signs of the slopes.
-    const int sx = (dx == 0 ? 0 : SGN(dx));
-    const int sy = (dy == 0 ? 0 : SGN(dy));
-    const int sz = (dz == 0 ? 0 : SGN(dz));
+    const int sx = SGN( dx );
+    const int sy = SGN( dy );
+    const int sz = SGN( dz );
     // Absolute values of slope components, x2 to avoid rounding errors.
-    const int ax = abs(dx) * 2;
-    const int ay = abs(dy) * 2;
-    const int az = abs(dz) * 2;
-
-    tripoint cur( loc1 );
+    const int ax = abs( dx ) * 2;
+    const int ay = abs( dy ) * 2;
+    const int az = abs( dz ) * 2;
 
     if( az == 0 ) {
         if( ax == ay ) {
-          while( cur.x != loc2.x ) {
-                cur.y += sy;
-                cur.x += sx;
-                if( !interact( cur ) ) {
-                    break;
-                }
-            }
-        } else if (ax > ay) {
-            while( cur.x != loc2.x ) {
-                if( t > 0 ) {
-                    cur.y += sy;
-                    t -= ax;
-                }
-                cur.x += sx;
-                t += ay;
-                if( !interact( cur ) ) {
-                    break;
-                }
-            }
+            major_x = sx;
+            major_y = sy;
+            left = abs( dx );
+        } else if( ax > ay ) {
+            major_x = sx;
+            major_len = ax;
+            minor_y = sy;
+            minor_len = ay;
+            left = abs( dx );
         } else {
-            while( cur.y != loc2.y ) {
-                if( t > 0 ) {
-                    cur.x += sx;
-                    t -= ay;
-                }
-                cur.y += sy;
-                t += ax;
-                if( !interact( cur ) ) {
-                    break;
-                }
-            }
+            major_y = sy;
+            major_len = ay;
+            minor_x = sx;
+            minor_len = ax;
+            left = abs( dy );
         }
     } else {
         if( ax == ay && ay == az ) {
-            while( cur.x != loc2.x ) {
-                cur.z += sz;
-                cur.y += sy;
-                cur.x += sx;
-                if( !interact( cur ) ) {
-                    break;
-                }
-            }
-        } else if( (az > ax) && (az > ay) ) {
-            while( cur.z != loc2.z ) {
-                if( t > 0 ) {
-                    cur.x += sx;
-                    t -= az;
-                }
-                if( t2 > 0 ) {
-                    cur.y += sy;
-                    t2 -= az;
-                }
-                cur.z += sz;
-                t += ax;
-                t2 += ay;
-                if( !interact( cur ) ) {
-                    break;
-                }
-            }
+            major_x = sx;
+            major_y = sy;
+            major_z = sz;
+            left = abs( dx );
+        } else if( az > ax && az > ay ) {
+            major_z = sz;
+            major_len = az;
+            minor_x = sx;
+            minor_len = ax;
+            minor2_y = sy;
+            minor2_len = ay;
+            left = abs( dz );
         } else if( ax == ay ) {
-            while( cur.x != loc2.x ) {
-                if( t > 0 ) {
-                    cur.z += sz;
-                    t -= ax;
-                }
-                cur.y += sy;
-                cur.x += sx;
-                t += az;
-                if( !interact( cur ) ) {
-                    break;
-                }
-            }
+            major_x = sx;
+            major_y = sy;
+            major_len = ax;
+            minor_z = sz;
+            minor_len = az;
+            left = abs( dx );
         } else if( ax > ay ) {
-            while( cur.x != loc2.x ) {
-                if( t > 0 ) {
-                    cur.y += sy;
-                    t -= ax;
-                }
-                if( t2 > 0 ) {
-                    cur.z += sz;
-                    t2 -= ax;
-                }
-                cur.x += sx;
-                t += ay;
-                t2 += az;
-                if( !interact( cur ) ) {
-                    break;
-                }
-            }
+            major_x = sx;
+            major_len = ax;
+            minor_y = sy;
+            minor_len = ay;
+            minor2_z = sz;
+            minor2_len = az;
+            left = abs( dx );
         } else { //dy > dx >= dz
-            while( cur.y != loc2.y ) {
-                if( t > 0 ) {
-                    cur.x += sx;
-                    t -= ay;
-                }
-                if( t2 > 0 ) {
-                    cur.z += sz;
-                    t2 -= ay;
-                }
-                cur.y += sy;
-                t += ax;
-                t2 += az;
-                if( !interact( cur ) ) {
-                    break;
-                }
-            }
+            major_y = sy;
+            major_len = ay;
+            minor_x = sx;
+            minor_len = ax;
+            minor2_z = sz;
+            minor2_len = az;
+            left = abs( dy );
         }
     }
 }
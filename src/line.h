@@ -5,6 +5,7 @@
 #include <string>
 #include "enums.h"
 #include <functional>
+#include <iterator>
 #include <math.h>
 
 #include "game_constants.h"
@@ -90,14 +91,157 @@ std::string const &direction_name_short( direction dir );
 /* Get suffix describing vector from p to q (eg. 1NW, 2SE) or empty string if p == q */
 std::string direction_suffix( const tripoint &p, const tripoint &q );
 
+/**
+ * The state of the bresenham algorithm on a line from `from` to `to`, @ref step moves
+ * to the next square. The start itself is not part of the line. This is what
+ * @ref bresenham and @ref line_view use, it does not allocate and is cheap to copy.
+ */
+class bresenham_state
+{
+    public:
+        /** @param t,t2 Decide which bresenham line is used, see @ref line_to. */
+        bresenham_state( const tripoint &from, const tripoint &to, int t, int t2 );
+
+        /** Number of squares of the line that were not visited yet. */
+        int remaining() const {
+            return left;
+        }
+        const tripoint &pos() const {
+            return cur;
+        }
+        /** Moves to the next square, only valid if @ref remaining is larger than 0. */
+        void step() {
+            if( t > 0 ) {
+                cur.x += minor_x;
+                cur.y += minor_y;
+                cur.z += minor_z;
+                t -= major_len;
+            }
+            if( t2 > 0 ) {
+                cur.x += minor2_x;
+                cur.y += minor2_y;
+                cur.z += minor2_z;
+                t2 -= major_len;
+            }
+            cur.x += major_x;
+            cur.y += major_y;
+            cur.z += major_z;
+            t += minor_len;
+            t2 += minor2_len;
+            left--;
+        }
+
+    private:
+        tripoint cur;
+        int t;
+        int t2;
+        int left = 0;
+        // Every step moves along the major axes and, depending on the errors t and t2,
+        // along the minor axes. The lengths are doubled to avoid rounding.
+        int major_x = 0;
+        int major_y = 0;
+        int major_z = 0;
+        int major_len = 0;
+        int minor_x = 0;
+        int minor_y = 0;
+        int minor_z = 0;
+        int minor_len = 0;
+        int minor2_x = 0;
+        int minor2_y = 0;
+        int minor2_z = 0;
+        int minor2_len = 0;
+};
+
 /**
  * The actual bresenham algorithm in 2D and 3D, everything else should call these
  * and pass in an interact functor to iterate across a line between two points.
+ * The functor returns false to stop early. It is a template parameter, so it gets
+ * inlined into the loop.
  */
-void bresenham( const int x1, const int y1, const int x2, const int y2, int t,
-                const std::function<bool( const point & )> &interact );
-void bresenham( const tripoint &loc1, const tripoint &loc2, int t, int t2,
-                const std::function<bool( const tripoint & )> &interact );
+template<typename Interact>
+void bresenham( const int x1, const int y1, const int x2, const int y2, int t, Interact interact )
+{
+    bresenham_state line( tripoint( x1, y1, 0 ), tripoint( x2, y2, 0 ), t, 0 );
+    while( line.remaining() > 0 ) {
+        line.step();
+        if( !interact( point( line.pos().x, line.pos().y ) ) ) {
+            break;
+        }
+    }
+}
+
+template<typename Interact>
+void bresenham( const tripoint &loc1, const tripoint &loc2, int t, int t2, Interact interact )
+{
+    bresenham_state line( loc1, loc2, t, t2 );
+    while( line.remaining() > 0 ) {
+        line.step();
+        if( !interact( line.pos() ) ) {
+            break;
+        }
+    }
+}
+
+/**
+ * The squares of a line without storing them, for range based for loops:
+ * `for( const tripoint &p : line_view( from, to ) )`. Unlike @ref line_to, a line
+ * from a point to itself is empty.
+ */
+class line_view
+{
+    public:
+        class iterator : public std::iterator<std::forward_iterator_tag, tripoint>
+        {
+            public:
+                /** Starts on the first square of the line unless `left` is 0. */
+                iterator( const bresenham_state &state, int left ) : state( state ), left( left ) {
+                    if( left > 0 ) {
+                        this->state.step();
+                    }
+                }
+
+                const tripoint &operator*() const {
+                    return state.pos();
+                }
+                const tripoint *operator->() const {
+                    return &state.pos();
+                }
+                iterator &operator++() {
+                    if( --left > 0 ) {
+                        state.step();
+                    }
+                    return *this;
+                }
+                bool operator==( const iterator &rhs ) const {
+                    return left == rhs.left;
+                }
+                bool operator!=( const iterator &rhs ) const {
+                    return left != rhs.left;
+                }
+
+            private:
+                bresenham_state state;
+                int left;
+        };
+
+        line_view( const tripoint &from, const tripoint &to, int t = 0, int t2 = 0 )
+            : state( from, to, t, t2 ) {}
+
+        iterator begin() const {
+            return iterator( state, state.remaining() );
+        }
+        iterator end() const {
+            return iterator( state, 0 );
+        }
+        /** Number of squares on the line. */
+        size_t size() const {
+            return state.remaining();
+        }
+
+    private:
+        bresenham_state state;
+};
+
 
 tripoint move_along_line( const tripoint &loc, const std::vector<tripoint> &line,
                           const int distance );
@@ -15,6 +15,7 @@
 #include "mapsharing.h"
 #include "output.h"
 #include "main_menu.h"
+#include "input_replay.h"
 
 #include <cstring>
 #include <ctime>
@@ -65,6 +66,8 @@ int main(int argc, char *argv[])
     dump_mode dmode = dump_mode::TSV;
     std::vector<std::string> opts;
     std::string world; /** if set try to load first save in this world on startup */
+    std::string record_file; /** if set record the input of the session to this file */
+    std::string memory_world; /** if set dump the memory usage after loading this world */
 
     // Set default file paths
 #ifdef PREFIX
@@ -148,6 +151,19 @@ int main(int argc, char *argv[])
                     return 0;
                 }
             },
+            {
+                "--dump-memory", "<world>",
+                "Loads the first save of the world and dumps its memory usage",
+                section_default,
+                [&memory_world](int n, const char *params[]) -> int {
+                    if( n < 1 ) {
+                        return -1;
+                    }
+                    test_mode = true;
+                    memory_world = params[0];
+                    return 1;
+                }
+            },
             {
                 "--world", "<name>",
                 "Load world",
@@ -160,6 +176,35 @@ int main(int argc, char *argv[])
                     return 1;
                 }
             },
+            {
+                "--record", "<file>",
+                "Records all input of the session to the file, use with --world",
+                section_default,
+                [&record_file](int n, const char *params[]) -> int {
+                    if( n < 1 ) {
+                        return -1;
+                    }
+                    record_file = params[0];
+                    return 1;
+                }
+            },
+            {
+                "--replay", "<file>",
+                "Replays a session recorded with --record and reports turn timings",
+                section_default,
+                [&seed,&world](int n, const char *params[]) -> int {
+                    if( n < 1 ) {
+                        return -1;
+                    }
+                    if( !input_replay::start_replay( params[0] ) ) {
+                        printf( "Could not read recorded session %s\n", params[0] );
+                        exit( 1 );
+                    }
+                    seed = input_replay::replay_seed();
+                    world = input_replay::replay_world();
+                    return 1;
+                }
+            },
             {
                 "--basepath", "<path>",
                 "Base path for all game data subdirectories",
@@ -432,6 +477,9 @@ int main(int argc, char *argv[])
     set_escdelay(10); // Make escape actually responsive
 
     srand(seed);
+    if( !record_file.empty() ) {
+        input_replay::start_recording( record_file, seed );
+    }
 
     g = new game;
     // First load and initialize everything that does not
@@ -448,6 +496,10 @@ int main(int argc, char *argv[])
             init_colors();
             exit( g->dump_stats( dump, dmode, opts ) ? 0 : 1 );
         }
+        if( !memory_world.empty() ) {
+            init_colors();
+            exit( g->dump_memory_usage( memory_world ) ? 0 : 1 );
+        }
         if( check_mods ) {
             init_colors();
             exit( g->check_mod_data( opts ) && !test_dirty ? 0 : 1 );
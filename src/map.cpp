@@ -36,6 +36,7 @@
 #include "scent_map.h"
 #include "cata_utility.h"
 #include "harvest.h"
+#include "task_scheduler.h"
 
 #include <cmath>
 #include <stdlib.h>
@@ -59,6 +60,7 @@ const efftype_id effect_stunned( "stunned" );
 extern bool is_valid_in_w_terrain(int,int);
 
 #include "overmapbuffer.h"
+#include "memory_usage.h"
 
 #define SGN(a) (((a)<0) ? -1 : 1)
 #define INBOUNDS(x, y) \
@@ -4734,7 +4736,7 @@ void map::process_items_in_submap( submap *const current_submap,
     // Get a COPY of the active item list for this submap.
     // If more are added as a side effect of processing, they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
-    std::list<item_reference> active_items = current_submap->active_items.get();
+    auto active_items = current_submap->active_items.get();
     auto const grid_offset = point {gridp.x * SEEX, gridp.y * SEEY};
     for( auto &active_item : active_items ) {
         if( !current_submap->active_items.has( active_item ) ) {
@@ -5373,6 +5375,7 @@ int map::set_field_strength( const tripoint &p, const field_id t, const int str,
         int adj = ( isoffset ? field_ptr->getFieldDensity() : 0 ) + str;
         if( adj > 0 ) {
             field_ptr->setFieldDensity( adj );
+            update_transparency_cache( p );
             return adj;
         } else {
             remove_field( p, t );
@@ -5437,9 +5440,7 @@ bool map::add_field(const tripoint &p, const field_id t, int density, const int
         creature_in_field( g->u ); //Hit the player with the field if it spawned on top of them.
     }
 
-    // Dirty the transparency cache now that field processing doesn't always do it
-    // TODO: Make it skip transparent fields
-    set_transparency_cache_dirty( p.z );
+    update_transparency_cache( p );
 
     if( field_type_dangerous( t ) ) {
         set_pathfinding_cache_dirty( p.z );
@@ -5460,13 +5461,8 @@ void map::remove_field( const tripoint &p, const field_id field_to_remove )
     if( current_submap->fld[lx][ly].removeField( field_to_remove ) ) {
         // Only adjust the count if the field actually existed.
         current_submap->field_count--;
+        update_transparency_cache( p );
         const auto &fdata = fieldlist[ field_to_remove ];
-        for( int i = 0; i < 3; ++i ) {
-            if( !fdata.transparent[i] ) {
-                set_transparency_cache_dirty( p.z );
-                break;
-            }
-        }
 
         for( int i = 0; i < 3; ++i ) {
             if( fdata.dangerous[i] ) {
@@ -6124,13 +6120,15 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range, int &bres
 
     // Ugly `if` for now
     if( !fov_3d || F.z == T.z ) {
+        // Same as trans(), but without looking up the cache for every square.
+        const auto &transparency = get_cache_ref( T.z ).transparency_cache;
         bresenham( F.x, F.y, T.x, T.y, bresenham_slope,
-                   [this, &visible, &T]( const point &new_point ) {
+                   [&transparency, &visible, &T]( const point &new_point ) {
                        // Exit before checking the last square, it's still visible even if opaque.
                        if( new_point.x == T.x && new_point.y == T.y ) {
                            return false;
                        }
-                       if( !this->trans( tripoint( new_point, T.z ) ) ) {
+                       if( transparency[new_point.x][new_point.y] <= LIGHT_TRANSPARENCY_SOLID ) {
                            visible = false;
                            return false;
                        }
@@ -6601,6 +6599,7 @@ void map::loadn( const int gridx, const int gridy, const int gridz, const bool u
     // Cache empty overmap types
     static const oter_id rock("empty_rock");
     static const oter_id air("open_air");
+    memory_usage::tag_scope tag( memory_usage::tag::mapbuffer );
 
     dbg(D_INFO) << "map::loadn(game[" << g << "], worldx[" << abs_sub.x << "], worldy[" << abs_sub.y << "], gridx["
                 << gridx << "], gridy[" << gridy << "], gridz[" << gridz << "])";
@@ -7482,20 +7481,28 @@ void map::build_floor_caches()
 {
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
-    for( int z = minz; z <= maxz; z++ ) {
-        build_floor_cache( z );
-    }
+    // The caches of each z-level only depend on that level.
+    tasks::parallel_for( minz + OVERMAP_DEPTH, maxz + OVERMAP_DEPTH + 1, 1,
+    [this]( const size_t b, const size_t e ) {
+        for( size_t i = b; i < e; i++ ) {
+            build_floor_cache( static_cast<int>( i ) - OVERMAP_DEPTH );
+        }
+    } );
 }
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
-    for( int z = minz; z <= maxz; z++ ) {
-        build_outside_cache( z );
-        build_transparency_cache( z );
-        build_floor_cache( z );
-    }
+    tasks::parallel_for( minz + OVERMAP_DEPTH, maxz + OVERMAP_DEPTH + 1, 1,
+    [this]( const size_t b, const size_t e ) {
+        for( size_t i = b; i < e; i++ ) {
+            const int z = static_cast<int>( i ) - OVERMAP_DEPTH;
+            build_outside_cache( z );
+            build_transparency_cache( z );
+            build_floor_cache( z );
+        }
+    } );
 
     tripoint start( 0, 0, minz );
     tripoint end( my_MAPSIZE * SEEX, my_MAPSIZE * SEEY, maxz );
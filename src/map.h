@@ -19,6 +19,7 @@
 #include "enums.h"
 #include "pathfinding.h"
 #include "emit.h"
+#include "scratch_arena.h"
 
 //TODO: include comments about how these variables work. Where are they used. Are they constant etc.
 #define CAMPSIZE 1
@@ -71,7 +72,7 @@ struct wrapped_vehicle{
  vehicle* v;
 };
 
-typedef std::vector<wrapped_vehicle> VehicleList;
+typedef scratch_vector<wrapped_vehicle> VehicleList;
 typedef std::vector< std::pair< item*, int > > itemslice;
 typedef std::string items_location;
 struct vehicle_prototype;
@@ -1248,6 +1249,16 @@ protected:
                 const int zlevel, const regional_settings * rsettings);
 
  void build_transparency_cache( int zlev );
+    /** Transparency of a tile as stored in the transparency cache, ignoring vehicles. */
+    float tile_transparency( const submap &sm, int sx, int sy, bool outside ) const;
+    /**
+     * Recomputes the transparency cache entries of the submap at grid position
+     * (@p smx, @p smy, @p zlev), unless the whole cache is going to be rebuilt anyway.
+     * @return Whether any entry changed.
+     */
+    bool update_transparency_cache( int smx, int smy, int zlev );
+    /** Same as above, but only for the tile at @p p. */
+    bool update_transparency_cache( const tripoint &p );
 public:
  void build_outside_cache( int zlev );
     void build_floor_cache( int zlev );
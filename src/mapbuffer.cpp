@@ -14,8 +14,14 @@
 #include "trap.h"
 #include "vehicle.h"
 #include "submap.h"
+#include "options.h"
+#include "json.h"
 
+#include <algorithm>
+#include <functional>
 #include <sstream>
+#include <tuple>
+#include <vector>
 
 #define dbg(x) DebugLog((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
@@ -160,234 +166,302 @@ void mapbuffer::save( bool delete_after_save )
     }
 }
 
-void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
-                           const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                           bool delete_after_save )
+namespace
 {
-    std::vector<point> offsets;
-    std::vector<tripoint> submap_addrs;
-    offsets.push_back( point(0, 0) );
-    offsets.push_back( point(0, 1) );
-    offsets.push_back( point(1, 0) );
-    offsets.push_back( point(1, 1) );
 
-    bool all_uniform = true;
-    for( auto &offsets_offset : offsets ) {
-        tripoint submap_addr = omt_to_sm_copy( om_addr );
-        submap_addr.x += offsets_offset.x;
-        submap_addr.y += offsets_offset.y;
-        submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr];
-        if( sm != nullptr && !sm->is_uniform ) {
-            all_uniform = false;
+/** Whether the submap contains nothing but a single type of terrain. */
+bool has_uniform_terrain( const submap &sm )
+{
+    const ter_id ter = sm.ter[0][0];
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( sm.ter[i][j] != ter || sm.frn[i][j] != f_null || sm.trp[i][j] != tr_null ||
+                sm.rad[i][j] != 0 || !sm.itm[i][j].empty() || sm.fld[i][j].fieldCount() > 0 ||
+                !sm.cosmetics[i][j].empty() ) {
+                return false;
+            }
         }
     }
+    return sm.spawns.empty() && sm.vehicles.empty() && sm.comp.name.empty() && !sm.camp.is_valid();
+}
 
-    if( all_uniform ) {
-        // Nothing to save - this quad will be regenerated faster than it would be re-read
-        if( delete_after_save ) {
-            for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
-                    submaps_to_delete.push_back( submap_addr );
-                }
-            }
-        }
+/** Writes the content of the submap as members of the current object. */
+void serialize_submap( JsonOut &jsout, const submap &sm )
+{
+    jsout.member( "turn_last_touched", sm.turn_last_touched );
+    jsout.member( "temperature", sm.temperature );
 
+    if( has_uniform_terrain( sm ) ) {
+        // Nothing but a single terrain type, which is all that needs to be stored.
+        jsout.member( "uniform_terrain", sm.ter[0][0].obj().id );
         return;
     }
 
-    // Don't create the directory if it would be empty
-    assure_dir_exist( dirname.c_str() );
-    ofstream_wrapper_exclusive fout( filename );
-    JsonOut jsout( fout );
+    jsout.member( "terrain" );
     jsout.start_array();
-    for( auto &submap_addr : submap_addrs ) {
-        if( submaps.count( submap_addr ) == 0 ) {
-            continue;
+    for(int j = 0; j < SEEY; j++) {
+        for(int i = 0; i < SEEX; i++) {
+            // Save terrains
+            jsout.write( sm.ter[i][j].obj().id );
         }
+    }
+    jsout.end_array();
 
-        submap *sm = submaps[submap_addr];
-        if( sm == nullptr ) {
-            continue;
-        }
-
-        jsout.start_object();
-
-        jsout.member( "version", savegame_version);
-
-        jsout.member( "coordinates" );
-        jsout.start_array();
-        jsout.write( submap_addr.x );
-        jsout.write( submap_addr.y );
-        jsout.write( submap_addr.z );
-        jsout.end_array();
-
-        jsout.member( "turn_last_touched", sm->turn_last_touched );
-        jsout.member( "temperature", sm->temperature );
-
-        jsout.member( "terrain" );
-        jsout.start_array();
-        for(int j = 0; j < SEEY; j++) {
-            for(int i = 0; i < SEEX; i++) {
-                // Save terrains
-                jsout.write( sm->ter[i][j].obj().id );
+    // Write out the radiation array in a simple RLE scheme.
+    // written in intensity, count pairs
+    jsout.member( "radiation" );
+    jsout.start_array();
+    int lastrad = -1;
+    int count = 0;
+    for(int j = 0; j < SEEY; j++) {
+        for(int i = 0; i < SEEX; i++) {
+            // Save radiation, re-examine this because it doesn't look like it works right
+            int r = sm.get_radiation(i, j);
+            if (r == lastrad) {
+                count++;
+            } else {
+                if (count) {
+                    jsout.write( count );
+                }
+                jsout.write( r );
+                lastrad = r;
+                count = 1;
             }
         }
-        jsout.end_array();
+    }
+    jsout.write( count );
+    jsout.end_array();
 
-        // Write out the radiation array in a simple RLE scheme.
-        // written in intensity, count pairs
-        jsout.member( "radiation" );
-        jsout.start_array();
-        int lastrad = -1;
-        int count = 0;
-        for(int j = 0; j < SEEY; j++) {
-            for(int i = 0; i < SEEX; i++) {
-                // Save radiation, re-examine this because it doesn't look like it works right
-                int r = sm->get_radiation(i, j);
-                if (r == lastrad) {
-                    count++;
-                } else {
-                    if (count) {
-                        jsout.write( count );
-                    }
-                    jsout.write( r );
-                    lastrad = r;
-                    count = 1;
-                }
+    jsout.member("furniture");
+    jsout.start_array();
+    for(int j = 0; j < SEEY; j++) {
+        for(int i = 0; i < SEEX; i++) {
+            // Save furniture
+            if( sm.get_furn( i, j ) != f_null ) {
+                jsout.start_array();
+                jsout.write( i );
+                jsout.write( j );
+                jsout.write( sm.get_furn( i, j ).obj().id );
+                jsout.end_array();
             }
         }
-        jsout.write( count );
-        jsout.end_array();
+    }
+    jsout.end_array();
 
-        jsout.member("furniture");
-        jsout.start_array();
-        for(int j = 0; j < SEEY; j++) {
-            for(int i = 0; i < SEEX; i++) {
-                // Save furniture
-                if( sm->get_furn( i, j ) != f_null ) {
-                    jsout.start_array();
-                    jsout.write( i );
-                    jsout.write( j );
-                    jsout.write( sm->get_furn( i, j ).obj().id );
-                    jsout.end_array();
-                }
+    jsout.member( "items" );
+    jsout.start_array();
+    for(int j = 0; j < SEEY; j++) {
+        for(int i = 0; i < SEEX; i++) {
+            if( sm.itm[i][j].empty() ) {
+                continue;
             }
+            jsout.write( i );
+            jsout.write( j );
+            jsout.write( sm.itm[i][j] );
         }
-        jsout.end_array();
+    }
+    jsout.end_array();
 
-        jsout.member( "items" );
-        jsout.start_array();
-        for(int j = 0; j < SEEY; j++) {
-            for(int i = 0; i < SEEX; i++) {
-                if( sm->itm[i][j].empty() ) {
-                    continue;
-                }
+    jsout.member( "traps" );
+    jsout.start_array();
+    for(int j = 0; j < SEEY; j++) {
+        for(int i = 0; i < SEEX; i++) {
+            // Save traps
+            if (sm.get_trap( i, j ) != tr_null) {
+                jsout.start_array();
                 jsout.write( i );
                 jsout.write( j );
-                jsout.write( sm->itm[i][j] );
+                // TODO: jsout should support writting an id like jsout.write( trap_id )
+                jsout.write( sm.get_trap( i, j ).id().str() );
+                jsout.end_array();
             }
         }
-        jsout.end_array();
+    }
+    jsout.end_array();
 
-        jsout.member( "traps" );
-        jsout.start_array();
-        for(int j = 0; j < SEEY; j++) {
-            for(int i = 0; i < SEEX; i++) {
-                // Save traps
-                if (sm->get_trap( i, j ) != tr_null) {
-                    jsout.start_array();
-                    jsout.write( i );
-                    jsout.write( j );
-                    // TODO: jsout should support writting an id like jsout.write( trap_id )
-                    jsout.write( sm->get_trap( i, j ).id().str() );
-                    jsout.end_array();
+    jsout.member( "fields" );
+    jsout.start_array();
+    for(int j = 0; j < SEEY; j++) {
+        for(int i = 0; i < SEEX; i++) {
+            // Save fields
+            if (sm.fld[i][j].fieldCount() > 0) {
+                jsout.write( i );
+                jsout.write( j );
+                jsout.start_array();
+                for( auto &fld : sm.fld[i][j] ) {
+                    const field_entry &cur = fld.second;
+                        // We don't seem to have a string identifier for fields anywhere.
+                        jsout.write( cur.getFieldType() );
+                        jsout.write( cur.getFieldDensity() );
+                        jsout.write( cur.getFieldAge() );
                 }
+                jsout.end_array();
             }
         }
-        jsout.end_array();
+    }
+    jsout.end_array();
 
-        jsout.member( "fields" );
-        jsout.start_array();
-        for(int j = 0; j < SEEY; j++) {
-            for(int i = 0; i < SEEX; i++) {
-                // Save fields
-                if (sm->fld[i][j].fieldCount() > 0) {
-                    jsout.write( i );
-                    jsout.write( j );
-                    jsout.start_array();
-                    for( auto &fld : sm->fld[i][j] ) {
-                        const field_entry &cur = fld.second;
-                            // We don't seem to have a string identifier for fields anywhere.
-                            jsout.write( cur.getFieldType() );
-                            jsout.write( cur.getFieldDensity() );
-                            jsout.write( cur.getFieldAge() );
-                    }
-                    jsout.end_array();
-                }
+    jsout.member("cosmetics");
+    jsout.start_array();
+    for (int j = 0; j < SEEY; j++) {
+        for (int i = 0; i < SEEX; i++) {
+            if (sm.cosmetics[i][j].size() > 0) {
+                jsout.start_array();
+                jsout.write(i);
+                jsout.write(j);
+                jsout.write(sm.cosmetics[i][j]);
+                jsout.end_array();
             }
         }
-        jsout.end_array();
+    }
+    jsout.end_array();
 
-        jsout.member("cosmetics");
+    // Output the spawn points
+    jsout.member( "spawns" );
+    jsout.start_array();
+    for( auto &elem : sm.spawns ) {
         jsout.start_array();
-        for (int j = 0; j < SEEY; j++) {
-            for (int i = 0; i < SEEX; i++) {
-                if (sm->cosmetics[i][j].size() > 0) {
-                    jsout.start_array();
-                    jsout.write(i);
-                    jsout.write(j);
-                    jsout.write(sm->cosmetics[i][j]);
-                    jsout.end_array();
-                }
-            }
-        }
+        jsout.write( elem.type.str() ); // TODO: json should know how to write string_ids
+        jsout.write( elem.count );
+        jsout.write( elem.posx );
+        jsout.write( elem.posy );
+        jsout.write( elem.faction_id );
+        jsout.write( elem.mission_id );
+        jsout.write( elem.friendly );
+        jsout.write( elem.name );
         jsout.end_array();
+    }
+    jsout.end_array();
 
-        // Output the spawn points
-        jsout.member( "spawns" );
-        jsout.start_array();
-        for( auto &elem : sm->spawns ) {
-            jsout.start_array();
-            jsout.write( elem.type.str() ); // TODO: json should know how to write string_ids
-            jsout.write( elem.count );
-            jsout.write( elem.posx );
-            jsout.write( elem.posy );
-            jsout.write( elem.faction_id );
-            jsout.write( elem.mission_id );
-            jsout.write( elem.friendly );
-            jsout.write( elem.name );
-            jsout.end_array();
+    jsout.member( "vehicles" );
+    jsout.start_array();
+    for( auto &elem : sm.vehicles ) {
+        // json lib doesn't know how to turn a vehicle * into a vehicle,
+        // so we have to iterate manually.
+        jsout.write( *elem );
+    }
+    jsout.end_array();
+
+    // Output the computer
+    if (sm.comp.name != "") {
+        jsout.member( "computers", sm.comp.save_data() );
+    }
+
+    // Output base camp if any
+    if (sm.camp.is_valid()) {
+        jsout.member( "camp" );
+        jsout.write( sm.camp.save_data() );
+    }
+}
+
+} // namespace
+
+void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
+                           const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
+                           bool delete_after_save )
+{
+    std::vector<point> offsets;
+    std::vector<tripoint> submap_addrs;
+    offsets.push_back( point(0, 0) );
+    offsets.push_back( point(0, 1) );
+    offsets.push_back( point(1, 0) );
+    offsets.push_back( point(1, 1) );
+
+    bool all_uniform = true;
+    for( auto &offsets_offset : offsets ) {
+        tripoint submap_addr = omt_to_sm_copy( om_addr );
+        submap_addr.x += offsets_offset.x;
+        submap_addr.y += offsets_offset.y;
+        submap_addrs.push_back( submap_addr );
+        submap *sm = submaps[submap_addr];
+        if( sm != nullptr && !sm->is_uniform ) {
+            all_uniform = false;
         }
-        jsout.end_array();
+    }
 
-        jsout.member( "vehicles" );
-        jsout.start_array();
-        for( auto &elem : sm->vehicles ) {
-            // json lib doesn't know how to turn a vehicle * into a vehicle,
-            // so we have to iterate manually.
-            jsout.write( *elem );
+    if( delete_after_save ) {
+        for( auto &submap_addr : submap_addrs ) {
+            if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                submaps_to_delete.push_back( submap_addr );
+            }
         }
-        jsout.end_array();
+    }
 
-        // Output the computer
-        if (sm->comp.name != "") {
-            jsout.member( "computers", sm->comp.save_data() );
+    if( all_uniform ) {
+        // Nothing to save - this quad will be regenerated faster than it would be re-read
+        return;
+    }
+
+    // Don't create the directory if it would be empty
+    assure_dir_exist( dirname.c_str() );
+    ofstream_wrapper_exclusive fout( filename, get_option<bool>( "SAVE_COMPRESSION" ) );
+    write_quad( fout.stream(), om_addr );
+    fout.close();
+}
+
+void mapbuffer::write_quad( std::ostream &fout, const tripoint &om_addr ) const
+{
+    const tripoint quad_origin = omt_to_sm_copy( om_addr );
+    // Content of the submaps written in full, later submaps with the same content refer to them.
+    std::vector<std::tuple<size_t, std::string, tripoint>> written;
+    bool first = true;
+    fout << '[';
+    for( const point &offset : { point( 0, 0 ), point( 0, 1 ), point( 1, 0 ), point( 1, 1 ) } ) {
+        const tripoint submap_addr( quad_origin.x + offset.x, quad_origin.y + offset.y, quad_origin.z );
+        const auto iter = submaps.find( submap_addr );
+        if( iter == submaps.end() || iter->second == nullptr ) {
+            continue;
+        }
+
+        std::ostringstream content;
+        {
+            JsonOut jsout( content );
+            jsout.start_object();
+            serialize_submap( jsout, *iter->second );
+            jsout.end_object();
+        }
+        const std::string body = content.str();
+        const size_t hash = std::hash<std::string>()( body );
+        const auto same = std::find_if( written.begin(), written.end(),
+        [&]( const std::tuple<size_t, std::string, tripoint> &entry ) {
+            return std::get<0>( entry ) == hash && std::get<1>( entry ) == body;
+        } );
+
+        std::ostringstream header;
+        {
+            JsonOut jsout( header );
+            jsout.start_object();
+            jsout.member( "version", savegame_version );
+            jsout.member( "coordinates" );
+            jsout.start_array();
+            jsout.write( submap_addr.x );
+            jsout.write( submap_addr.y );
+            jsout.write( submap_addr.z );
+            jsout.end_array();
+            if( same != written.end() ) {
+                const tripoint &other = std::get<2>( *same );
+                jsout.member( "same_as" );
+                jsout.start_array();
+                jsout.write( other.x );
+                jsout.write( other.y );
+                jsout.write( other.z );
+                jsout.end_array();
+                jsout.end_object();
+            }
         }
 
-        // Output base camp if any
-        if (sm->camp.is_valid()) {
-            jsout.member( "camp" );
-            jsout.write( sm->camp.save_data() );
+        if( !first ) {
+            fout << ',';
         }
-        if( delete_after_save ) {
-            submaps_to_delete.push_back( submap_addr );
+        first = false;
+        fout << header.str();
+        if( same == written.end() ) {
+            // Continue the object of the header with the members of the content.
+            fout << ',' << body.substr( 1 );
+            written.emplace_back( hash, body, submap_addr );
         }
-        jsout.end_object();
     }
-
-    jsout.end_array();
-    fout.close();
+    fout << ']';
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -417,203 +491,238 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
 
 void mapbuffer::deserialize( JsonIn &jsin )
 {
+    // Where the submaps read so far start, for the ones that refer to an identical submap.
+    std::map<tripoint, int> positions;
     jsin.start_array();
     while( !jsin.end_array() ) {
+        const int start = jsin.tell();
         std::unique_ptr<submap> sm(new submap());
-        tripoint submap_coordinates;
-        jsin.start_object();
-        bool rubpow_update = false;
-        while( !jsin.end_object() ) {
-            std::string submap_member_name = jsin.get_member_name();
-            if( submap_member_name == "version" ) {
-                if (jsin.get_int() < 22) {
-                    rubpow_update = true;
-                }
-            } else if( submap_member_name == "coordinates" ) {
-                jsin.start_array();
-                int locx = jsin.get_int();
-                int locy = jsin.get_int();
-                int locz = jsin.get_int();
-                jsin.end_array();
-                submap_coordinates = tripoint( locx, locy, locz );
-            } else if( submap_member_name == "turn_last_touched" ) {
-                sm->turn_last_touched = jsin.get_int();
-            } else if( submap_member_name == "temperature" ) {
-                sm->temperature = jsin.get_int();
-            } else if( submap_member_name == "terrain" ) {
-                // TODO: try block around this to error out if we come up short?
-                jsin.start_array();
-                // Small duplication here so that the update check is only performed once
-                if (rubpow_update) {
-                    item rock = item("rock", 0);
-                    item chunk = item("steel_chunk", 0);
-                    for( int j = 0; j < SEEY; j++ ) {
-                        for( int i = 0; i < SEEX; i++ ) {
-                            const ter_str_id tid( jsin.get_string() );
-
-                            if ( tid == "t_rubble" ) {
-                                sm->ter[i][j] = ter_id( "t_dirt" );
-                                sm->frn[i][j] = furn_id( "f_rubble" );
-                                sm->itm[i][j].push_back( rock );
-                                sm->itm[i][j].push_back( rock );
-                            } else if ( tid == "t_wreckage" ){
-                                sm->ter[i][j] = ter_id( "t_dirt" );
-                                sm->frn[i][j] = furn_id( "f_wreckage" );
-                                sm->itm[i][j].push_back( chunk );
-                                sm->itm[i][j].push_back( chunk );
-                            } else if ( tid == "t_ash" ){
-                                sm->ter[i][j] = ter_id(  "t_dirt" );
-                                sm->frn[i][j] = furn_id( "f_ash" );
-                            } else if ( tid == "t_pwr_sb_support_l" ){
-                                sm->ter[i][j] = ter_id(  "t_support_l" );
-                            } else if ( tid == "t_pwr_sb_switchgear_l" ){
-                                sm->ter[i][j] = ter_id(  "t_switchgear_l" );
-                            } else if ( tid == "t_pwr_sb_switchgear_s" ){
-                                sm->ter[i][j] = ter_id(  "t_switchgear_s" );
-                            } else {
-                                sm->ter[i][j] = tid.id();
-                            }
-                        }
-                    }
-                } else {
-                    for( int j = 0; j < SEEY; j++ ) {
-                        for( int i = 0; i < SEEX; i++ ) {
-                            const ter_str_id tid( jsin.get_string() );
+        const tripoint submap_coordinates = deserialize_submap( jsin, sm.get(), positions );
+        positions[submap_coordinates] = start;
+        if( !add_submap( submap_coordinates, sm ) ) {
+            debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
+                      submap_coordinates.z );
+        }
+    }
+}
+
+tripoint mapbuffer::deserialize_submap( JsonIn &jsin, submap *sm,
+                                        const std::map<tripoint, int> &positions )
+{
+    tripoint submap_coordinates;
+    jsin.start_object();
+    bool rubpow_update = false;
+    while( !jsin.end_object() ) {
+        std::string submap_member_name = jsin.get_member_name();
+        if( submap_member_name == "version" ) {
+            if (jsin.get_int() < 22) {
+                rubpow_update = true;
+            }
+        } else if( submap_member_name == "coordinates" ) {
+            jsin.start_array();
+            int locx = jsin.get_int();
+            int locy = jsin.get_int();
+            int locz = jsin.get_int();
+            jsin.end_array();
+            submap_coordinates = tripoint( locx, locy, locz );
+        } else if( submap_member_name == "turn_last_touched" ) {
+            sm->turn_last_touched = jsin.get_int();
+        } else if( submap_member_name == "temperature" ) {
+            sm->temperature = jsin.get_int();
+        } else if( submap_member_name == "terrain" ) {
+            // TODO: try block around this to error out if we come up short?
+            jsin.start_array();
+            // Small duplication here so that the update check is only performed once
+            if (rubpow_update) {
+                item rock = item("rock", 0);
+                item chunk = item("steel_chunk", 0);
+                for( int j = 0; j < SEEY; j++ ) {
+                    for( int i = 0; i < SEEX; i++ ) {
+                        const ter_str_id tid( jsin.get_string() );
+
+                        if ( tid == "t_rubble" ) {
+                            sm->ter[i][j] = ter_id( "t_dirt" );
+                            sm->frn[i][j] = furn_id( "f_rubble" );
+                            sm->itm[i][j].push_back( rock );
+                            sm->itm[i][j].push_back( rock );
+                        } else if ( tid == "t_wreckage" ){
+                            sm->ter[i][j] = ter_id( "t_dirt" );
+                            sm->frn[i][j] = furn_id( "f_wreckage" );
+                            sm->itm[i][j].push_back( chunk );
+                            sm->itm[i][j].push_back( chunk );
+                        } else if ( tid == "t_ash" ){
+                            sm->ter[i][j] = ter_id(  "t_dirt" );
+                            sm->frn[i][j] = furn_id( "f_ash" );
+                        } else if ( tid == "t_pwr_sb_support_l" ){
+                            sm->ter[i][j] = ter_id(  "t_support_l" );
+                        } else if ( tid == "t_pwr_sb_switchgear_l" ){
+                            sm->ter[i][j] = ter_id(  "t_switchgear_l" );
+                        } else if ( tid == "t_pwr_sb_switchgear_s" ){
+                            sm->ter[i][j] = ter_id(  "t_switchgear_s" );
+                        } else {
                             sm->ter[i][j] = tid.id();
                         }
                     }
                 }
-                jsin.end_array();
-            } else if( submap_member_name == "radiation" ) {
-                int rad_cell = 0;
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    int rad_strength = jsin.get_int();
-                    int rad_num = jsin.get_int();
-                    for( int i = 0; i < rad_num; ++i ) {
-                        // A little array trick here, assign to it as a 1D array.
-                        // If it's not in bounds we're kinda hosed anyway.
-                        sm->set_radiation(0, rad_cell, rad_strength);
-                        rad_cell++;
+            } else {
+                for( int j = 0; j < SEEY; j++ ) {
+                    for( int i = 0; i < SEEX; i++ ) {
+                        const ter_str_id tid( jsin.get_string() );
+                        sm->ter[i][j] = tid.id();
                     }
                 }
-            } else if( submap_member_name == "furniture" ) {
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    jsin.start_array();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    sm->frn[i][j] = furn_id( jsin.get_string() );
-                    jsin.end_array();
+            }
+            jsin.end_array();
+        } else if( submap_member_name == "radiation" ) {
+            int rad_cell = 0;
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                int rad_strength = jsin.get_int();
+                int rad_num = jsin.get_int();
+                for( int i = 0; i < rad_num; ++i ) {
+                    // A little array trick here, assign to it as a 1D array.
+                    // If it's not in bounds we're kinda hosed anyway.
+                    sm->set_radiation(0, rad_cell, rad_strength);
+                    rad_cell++;
                 }
-            } else if( submap_member_name == "items" ) {
+            }
+        } else if( submap_member_name == "furniture" ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                jsin.start_array();
+                int i = jsin.get_int();
+                int j = jsin.get_int();
+                sm->frn[i][j] = furn_id( jsin.get_string() );
+                jsin.end_array();
+            }
+        } else if( submap_member_name == "items" ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                int i = jsin.get_int();
+                int j = jsin.get_int();
                 jsin.start_array();
                 while( !jsin.end_array() ) {
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    jsin.start_array();
-                    while( !jsin.end_array() ) {
-                        item tmp;
-                        jsin.read( tmp );
-
-                        if( tmp.is_emissive() ) {
-                            sm->update_lum_add(tmp, i, j);
-                        }
+                    item tmp;
+                    jsin.read( tmp );
 
-                        tmp.visit_items( [ &sm, i, j ]( item *it ) {
-                            for( auto& e: it->magazine_convert() ) {
-                                sm->itm[i][j].push_back( e );
-                            }
-                            return VisitResponse::NEXT;
-                        } );
+                    if( tmp.is_emissive() ) {
+                        sm->update_lum_add(tmp, i, j);
+                    }
 
-                        sm->itm[i][j].push_back( tmp );
-                        if( tmp.needs_processing() ) {
-                            sm->active_items.add( std::prev(sm->itm[i][j].end()), point( i, j ) );
+                    tmp.visit_items( [ &sm, i, j ]( item *it ) {
+                        for( auto& e: it->magazine_convert() ) {
+                            sm->itm[i][j].push_back( e );
                         }
+                        return VisitResponse::NEXT;
+                    } );
+
+                    sm->itm[i][j].push_back( tmp );
+                    if( tmp.needs_processing() ) {
+                        sm->active_items.add( std::prev(sm->itm[i][j].end()), point( i, j ) );
                     }
                 }
-            } else if( submap_member_name == "traps" ) {
+            }
+        } else if( submap_member_name == "traps" ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
                 jsin.start_array();
-                while( !jsin.end_array() ) {
-                    jsin.start_array();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    // TODO: jsin should support returning an id like jsin.get_id<trap>()
-                    sm->trp[i][j] = trap_str_id( jsin.get_string() );
-                    jsin.end_array();
-                }
-            } else if( submap_member_name == "fields" ) {
+                int i = jsin.get_int();
+                int j = jsin.get_int();
+                // TODO: jsin should support returning an id like jsin.get_id<trap>()
+                sm->trp[i][j] = trap_str_id( jsin.get_string() );
+                jsin.end_array();
+            }
+        } else if( submap_member_name == "fields" ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                // Coordinates loop
+                int i = jsin.get_int();
+                int j = jsin.get_int();
                 jsin.start_array();
                 while( !jsin.end_array() ) {
-                    // Coordinates loop
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    jsin.start_array();
-                    while( !jsin.end_array() ) {
-                        int type = jsin.get_int();
-                        int density = jsin.get_int();
-                        int age = jsin.get_int();
-                        if (sm->fld[i][j].findField(field_id(type)) == NULL) {
-                            sm->field_count++;
-                        }
-                        sm->fld[i][j].addField(field_id(type), density, age);
+                    int type = jsin.get_int();
+                    int density = jsin.get_int();
+                    int age = jsin.get_int();
+                    if (sm->fld[i][j].findField(field_id(type)) == NULL) {
+                        sm->field_count++;
                     }
+                    sm->fld[i][j].addField(field_id(type), density, age);
                 }
-            } else if( submap_member_name == "graffiti" ) {
-                jsin.start_array();
-                while( !jsin.end_array() ) {
-                    jsin.start_array();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    sm->set_graffiti( i, j, jsin.get_string() );
-                    jsin.end_array();
-                }
-            } else if(submap_member_name == "cosmetics") {
+            }
+        } else if( submap_member_name == "graffiti" ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
                 jsin.start_array();
-                while (!jsin.end_array()) {
-                    jsin.start_array();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    jsin.read(sm->cosmetics[i][j]);
-                    jsin.end_array();
-                }
-            } else if( submap_member_name == "spawns" ) {
+                int i = jsin.get_int();
+                int j = jsin.get_int();
+                sm->set_graffiti( i, j, jsin.get_string() );
+                jsin.end_array();
+            }
+        } else if(submap_member_name == "cosmetics") {
+            jsin.start_array();
+            while (!jsin.end_array()) {
                 jsin.start_array();
-                while( !jsin.end_array() ) {
-                    jsin.start_array();
-                    const mtype_id type = mtype_id( jsin.get_string() ); // TODO: json should know how to read an string_id
-                    int count = jsin.get_int();
-                    int i = jsin.get_int();
-                    int j = jsin.get_int();
-                    int faction_id = jsin.get_int();
-                    int mission_id = jsin.get_int();
-                    bool friendly = jsin.get_bool();
-                    std::string name = jsin.get_string();
-                    jsin.end_array();
-                    spawn_point tmp( type, count, i, j, faction_id, mission_id, friendly, name );
-                    sm->spawns.push_back( tmp );
-                }
-            } else if( submap_member_name == "vehicles" ) {
+                int i = jsin.get_int();
+                int j = jsin.get_int();
+                jsin.read(sm->cosmetics[i][j]);
+                jsin.end_array();
+            }
+        } else if( submap_member_name == "spawns" ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
                 jsin.start_array();
-                while( !jsin.end_array() ) {
-                    vehicle *tmp = new vehicle();
-                    jsin.read( *tmp );
-                    sm->vehicles.push_back( tmp );
+                const mtype_id type = mtype_id( jsin.get_string() ); // TODO: json should know how to read an string_id
+                int count = jsin.get_int();
+                int i = jsin.get_int();
+                int j = jsin.get_int();
+                int faction_id = jsin.get_int();
+                int mission_id = jsin.get_int();
+                bool friendly = jsin.get_bool();
+                std::string name = jsin.get_string();
+                jsin.end_array();
+                spawn_point tmp( type, count, i, j, faction_id, mission_id, friendly, name );
+                sm->spawns.push_back( tmp );
+            }
+        } else if( submap_member_name == "vehicles" ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                vehicle *tmp = new vehicle();
+                jsin.read( *tmp );
+                sm->vehicles.push_back( tmp );
+            }
+        } else if( submap_member_name == "computers" ) {
+            std::string computer_data = jsin.get_string();
+            sm->comp.load_data( computer_data );
+        } else if( submap_member_name == "camp" ) {
+            std::string camp_data = jsin.get_string();
+            sm->camp.load_data( camp_data );
+        } else if( submap_member_name == "uniform_terrain" ) {
+            const ter_id tid = ter_str_id( jsin.get_string() ).id();
+            for( int j = 0; j < SEEY; j++ ) {
+                for( int i = 0; i < SEEX; i++ ) {
+                    sm->ter[i][j] = tid;
                 }
-            } else if( submap_member_name == "computers" ) {
-                std::string computer_data = jsin.get_string();
-                sm->comp.load_data( computer_data );
-            } else if( submap_member_name == "camp" ) {
-                std::string camp_data = jsin.get_string();
-                sm->camp.load_data( camp_data );
-            } else {
-                jsin.skip_value();
             }
-        }
-        if( !add_submap( submap_coordinates, sm ) ) {
-            debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
-                      submap_coordinates.z );
+        } else if( submap_member_name == "same_as" ) {
+            jsin.start_array();
+            const int locx = jsin.get_int();
+            const int locy = jsin.get_int();
+            const int locz = jsin.get_int();
+            jsin.end_array();
+            const auto iter = positions.find( tripoint( locx, locy, locz ) );
+            if( iter == positions.end() ) {
+                jsin.error( "submap refers to an unknown submap" );
+            }
+            // Read the content of the other submap again, this one keeps its own coordinates.
+            const int resume = jsin.tell();
+            const bool ate_separator = jsin.get_ate_separator();
+            jsin.seek( iter->second );
+            deserialize_submap( jsin, sm, positions );
+            jsin.seek( resume );
+            jsin.set_ate_separator( ate_separator );
+        } else {
+            jsin.skip_value();
         }
     }
+    return submap_coordinates;
 }
@@ -1,6 +1,7 @@
 #ifndef MAPBUFFER_H
 #define MAPBUFFER_H
 
+#include <iosfwd>
 #include <map>
 #include <list>
 #include <memory>
@@ -9,6 +10,7 @@
 struct point;
 struct tripoint;
 struct submap;
+class JsonIn;
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -57,6 +59,16 @@ class mapbuffer
         submap *lookup_submap( int x, int y, int z );
         submap *lookup_submap( const tripoint &p );
 
+        /**
+         * Writes the submaps of the overmap terrain tile at @p om_addr as they are
+         * stored in its quad file. Submaps that contain only one type of terrain
+         * are stored as just that terrain, submaps with the same content as one
+         * written before refer to that one.
+         */
+        void write_quad( std::ostream &fout, const tripoint &om_addr ) const;
+        /** Adds the submaps of a quad file (see @ref write_quad) to this buffer. */
+        void deserialize( JsonIn &jsin );
+
     private:
         typedef std::map<tripoint, submap *> submap_map_t;
 
@@ -73,7 +85,12 @@ class mapbuffer
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
-        void deserialize( JsonIn &jsin );
+        /**
+         * Reads one submap object into @p sm and returns its coordinates.
+         * @param positions Stream positions of the submaps read before.
+         */
+        tripoint deserialize_submap( JsonIn &jsin, submap *sm,
+                                     const std::map<tripoint, int> &positions );
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
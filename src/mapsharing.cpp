@@ -1,5 +1,7 @@
 #include "mapsharing.h"
 
+#include <cstdio>
+
 bool MAP_SHARING::sharing;
 bool MAP_SHARING::competitive;
 bool MAP_SHARING::worldmenu;
@@ -158,3 +160,80 @@ void fclose_exclusive( std::ofstream &fout, const char *filename )
     releaseLock( lockFiles[lockFile], lockFile.c_str() );
     lockFiles[lockFile] = -1;
 }
+
+version_index::version_index( const std::string &world_path ) : path( world_path + "/versions" )
+{
+}
+
+version_index::~version_index()
+{
+    if( locked ) {
+        commit();
+    }
+}
+
+void version_index::load()
+{
+    stamps.clear();
+    std::ifstream fin( path.c_str() );
+    std::string file;
+    int stamp = 0;
+    while( fin >> file >> stamp ) {
+        stamps[file] = stamp;
+    }
+}
+
+int version_index::get( const std::string &file ) const
+{
+    const auto iter = stamps.find( file );
+    return iter != stamps.end() ? iter->second : 0;
+}
+
+void version_index::lock()
+{
+#ifdef __linux__
+    // Unlike getLock, this waits for the other process and never removes the lock file:
+    // a process waiting on the removed file would not keep out the next one.
+    const std::string lockfile = path + ".lock";
+    mode_t m = umask( 0 );
+    lock_fd = open( lockfile.c_str(), O_RDWR | O_CREAT, 0666 );
+    umask( m );
+    if( lock_fd >= 0 ) {
+        flock( lock_fd, LOCK_EX );
+    }
+#endif // __linux__
+    locked = true;
+    load();
+}
+
+int version_index::bump( const std::string &file )
+{
+    changed = true;
+    return ++stamps[file];
+}
+
+void version_index::commit()
+{
+    if( changed ) {
+        // Readers don't lock, so they must never see a partially written index.
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream fout( tmp.c_str(), std::ios::trunc );
+            for( const auto &elem : stamps ) {
+                fout << elem.first << ' ' << elem.second << '\n';
+            }
+        }
+        if( rename( tmp.c_str(), path.c_str() ) != 0 ) {
+            remove( path.c_str() );
+            rename( tmp.c_str(), path.c_str() );
+        }
+        changed = false;
+    }
+#ifdef __linux__
+    if( lock_fd >= 0 ) {
+        close( lock_fd );
+        lock_fd = -1;
+    }
+#endif // __linux__
+    locked = false;
+}
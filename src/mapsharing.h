@@ -58,4 +58,45 @@ void fopen_exclusive( std::ofstream &fout, const char *filename,
 //std::ofstream fopen_exclusive(const char* filename);
 void fclose_exclusive( std::ofstream &fout, const char *filename );
 
+/**
+ * Version stamps of the files that several processes write when sharing a world: map quads
+ * and overmaps. Each write of such a file increases its stamp. The stamp is stored in the file
+ * and in this index, so a process can tell which files others wrote since it read them
+ * without reading the files themselves. Files are identified by their path relative to the
+ * world directory.
+ */
+class version_index
+{
+    public:
+        /** The index of the world in the given directory. */
+        explicit version_index( const std::string &world_path );
+        /** Calls @ref commit if the index is still locked. */
+        ~version_index();
+
+        version_index( const version_index & ) = delete;
+        version_index &operator=( const version_index & ) = delete;
+
+        /** Reads the index file. */
+        void load();
+        /** Stamp of the file as of the last load, 0 if it has never been written. */
+        int get( const std::string &file ) const;
+
+        /**
+         * Keeps other processes from changing the index until @ref commit and reads it.
+         * Hold the lock while writing the files, so they always match the index.
+         */
+        void lock();
+        /** Increases the stamp of the file and returns the new stamp. Requires @ref lock. */
+        int bump( const std::string &file );
+        /** Writes the index if it was changed and releases the lock. */
+        void commit();
+
+    private:
+        std::string path;
+        std::map<std::string, int> stamps;
+        int lock_fd = -1;
+        bool locked = false;
+        bool changed = false;
+};
+
 #endif
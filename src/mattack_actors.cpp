@@ -9,6 +9,7 @@
 #include "translations.h"
 #include "sounds.h"
 #include "npc.h"
+#include "fake_shooter.h"
 #include "debug.h"
 
 const efftype_id effect_bite( "bite" );
@@ -387,16 +388,20 @@ void gun_actor::shoot( monster &z, Creature &target, const std::string &mode ) c
         return;
     }
 
-    standard_npc tmp( _( "The " ) + z.name(), {}, 8, fake_str, fake_dex, fake_int, fake_per );
-    tmp.set_fake( true );
-    tmp.setpos( z.pos() );
-    tmp.attitude = z.friendly ? NPCATT_FOLLOW : NPCATT_KILL;
-    tmp.recoil = 0; // no need to aim
-
-    for( const auto &pr : fake_skills ) {
-        tmp.set_skill_level( pr.first, pr.second );
-    }
-
+    shooter_profile profile;
+    profile.name = _( "The " ) + z.name();
+    profile.pos = z.pos();
+    profile.str = fake_str;
+    profile.dex = fake_dex;
+    profile.intl = fake_int;
+    profile.per = fake_per;
+    profile.base_skill = 8;
+    profile.skills.assign( fake_skills.begin(), fake_skills.end() );
+    profile.friendly = z.friendly != 0;
+    profile.recoil = 0; // no need to aim
+
+    fake_shooter shooter( profile );
+    npc &tmp = *shooter;
     tmp.weapon = gun;
     tmp.i_add( item( "UPS_off", calendar::turn, 1000 ) );
 
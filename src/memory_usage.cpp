@@ -0,0 +1,280 @@
+#include "memory_usage.h"
+
+#include "game.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "mapbuffer.h"
+#include "monster.h"
+#include "monstergenerator.h"
+#include "mtype.h"
+#include "npc.h"
+#include "overmapbuffer.h"
+#include "player.h"
+#include "submap.h"
+#include "vehicle.h"
+#include "output.h"
+#ifdef TILES
+#include "cata_tiles.h"
+extern std::unique_ptr<cata_tiles> tilecontext;
+#endif
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+#ifdef MEMORY_TAGGING
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace
+{
+
+const char *tag_names[] = {
+    "untagged", "mapbuffer", "overmap", "game data", "tiles"
+};
+static_assert( sizeof( tag_names ) / sizeof( tag_names[0] ) ==
+               static_cast<size_t>( memory_usage::tag::num_tags ), "one name per tag" );
+
+size_t estimate_itype( const itype &type )
+{
+    using namespace memory_usage;
+    size_t result = sizeof( itype );
+    // Names are not accessible directly, the (translated) copies are close enough.
+    result += heap_size( type.get_id() ) + heap_size( type.nname( 1 ) ) + heap_size( type.nname( 2 ) );
+    result += heap_size( type.description ) + heap_size( type.snippet_category );
+    result += heap_size( type.properties ) + node_size( type.qualities );
+    result += heap_size( type.materials ) + node_size( type.use_methods );
+    result += node_size( type.item_tags ) + node_size( type.techniques );
+    result += type.container ? sizeof( islot_container ) : 0;
+    result += type.tool ? sizeof( islot_tool ) : 0;
+    result += type.comestible ? sizeof( islot_comestible ) : 0;
+    result += type.brewable ? sizeof( islot_brewable ) : 0;
+    result += type.armor ? sizeof( islot_armor ) : 0;
+    result += type.book ? sizeof( islot_book ) : 0;
+    result += type.mod ? sizeof( islot_mod ) : 0;
+    result += type.engine ? sizeof( islot_engine ) : 0;
+    result += type.wheel ? sizeof( islot_wheel ) : 0;
+    result += type.gun ? sizeof( islot_gun ) : 0;
+    result += type.gunmod ? sizeof( islot_gunmod ) : 0;
+    result += type.magazine ? sizeof( islot_magazine ) : 0;
+    result += type.bionic ? sizeof( islot_bionic ) : 0;
+    result += type.ammo ? sizeof( islot_ammo ) : 0;
+    result += type.seed ? sizeof( islot_seed ) : 0;
+    result += type.artifact ? sizeof( islot_artifact ) : 0;
+    return result;
+}
+
+size_t estimate_mtype( const mtype &type )
+{
+    using namespace memory_usage;
+    return sizeof( mtype ) + heap_size( type.nname( 1 ) ) + heap_size( type.nname( 2 ) ) +
+           heap_size( type.description ) + node_size( type.species ) + node_size( type.categories ) +
+           heap_size( type.special_attacks_names ) + node_size( type.special_attacks );
+}
+
+std::string format_bytes( size_t bytes )
+{
+    if( bytes >= 10 * 1024 * 1024 ) {
+        return string_format( "%d MiB", static_cast<int>( bytes / ( 1024 * 1024 ) ) );
+    }
+    return string_format( "%d KiB", static_cast<int>( bytes / 1024 ) );
+}
+
+void format_rows( std::ostringstream &out, const std::vector<memory_usage::subsystem_usage> &rows )
+{
+    for( const auto &row : rows ) {
+        out << string_format( "%-28s %8d %10s %10s\n", row.name.c_str(), static_cast<int>( row.count ),
+                              format_bytes( row.current ).c_str(), format_bytes( row.peak ).c_str() );
+    }
+}
+
+} // namespace
+
+#ifdef MEMORY_TAGGING
+
+namespace
+{
+
+/** Stored in front of every allocation so it can be attributed again when freed. */
+struct alignas( std::max_align_t ) allocation_header {
+    size_t size;
+    int tag;
+};
+
+constexpr int num_tags = static_cast<int>( memory_usage::tag::num_tags );
+std::atomic<size_t> tag_count[num_tags];
+std::atomic<size_t> tag_current[num_tags];
+std::atomic<size_t> tag_peak[num_tags];
+thread_local memory_usage::tag current_tag = memory_usage::tag::untagged;
+
+void *tagged_alloc( size_t size )
+{
+    auto header = static_cast<allocation_header *>( std::malloc( size + sizeof( allocation_header ) ) );
+    if( header == nullptr ) {
+        throw std::bad_alloc();
+    }
+    header->size = size;
+    header->tag = static_cast<int>( current_tag );
+    tag_count[header->tag]++;
+    const size_t now = tag_current[header->tag] += size;
+    size_t peak = tag_peak[header->tag];
+    while( now > peak && !tag_peak[header->tag].compare_exchange_weak( peak, now ) ) {
+    }
+    return header + 1;
+}
+
+void tagged_free( void *ptr )
+{
+    if( ptr == nullptr ) {
+        return;
+    }
+    auto header = static_cast<allocation_header *>( ptr ) - 1;
+    tag_count[header->tag]--;
+    tag_current[header->tag] -= header->size;
+    std::free( header );
+}
+
+} // namespace
+
+void *operator new( size_t size )
+{
+    return tagged_alloc( size );
+}
+
+void *operator new[]( size_t size )
+{
+    return tagged_alloc( size );
+}
+
+void operator delete( void *ptr ) noexcept
+{
+    tagged_free( ptr );
+}
+
+void operator delete[]( void *ptr ) noexcept
+{
+    tagged_free( ptr );
+}
+
+memory_usage::tag_scope::tag_scope( tag t ) : previous( current_tag )
+{
+    current_tag = t;
+}
+
+memory_usage::tag_scope::~tag_scope()
+{
+    current_tag = previous;
+}
+
+std::vector<memory_usage::subsystem_usage> memory_usage::tagged_allocations()
+{
+    std::vector<subsystem_usage> result;
+    for( int i = 0; i < num_tags; i++ ) {
+        subsystem_usage row;
+        row.name = std::string( "tag: " ) + tag_names[i];
+        row.count = tag_count[i];
+        row.current = tag_current[i];
+        row.peak = tag_peak[i];
+        result.push_back( row );
+    }
+    return result;
+}
+
+#else
+
+memory_usage::tag_scope::tag_scope( tag t ) : previous( t )
+{
+}
+
+memory_usage::tag_scope::~tag_scope() = default;
+
+std::vector<memory_usage::subsystem_usage> memory_usage::tagged_allocations()
+{
+    return std::vector<subsystem_usage>();
+}
+
+#endif
+
+std::vector<memory_usage::subsystem_usage> memory_usage::report()
+{
+    std::vector<subsystem_usage> result;
+    const auto add = [&result]( const std::string & name, size_t count, size_t bytes ) {
+        subsystem_usage row;
+        row.name = name;
+        row.count = count;
+        row.current = bytes;
+        result.push_back( row );
+    };
+
+    size_t submaps = 0;
+    size_t submap_bytes = 0;
+    size_t vehicles = 0;
+    size_t vehicle_bytes = 0;
+    for( const auto &sm : MAPBUFFER ) {
+        submaps++;
+        submap_bytes += sm.second->estimate_memory_usage();
+        for( const vehicle *veh : sm.second->vehicles ) {
+            vehicles++;
+            vehicle_bytes += veh->estimate_memory_usage();
+        }
+    }
+    add( "submaps (incl. vehicles)", submaps, submap_bytes );
+    add( "vehicles", vehicles, vehicle_bytes );
+
+    add( "overmaps", overmap_buffer.loaded_count(), overmap_buffer.estimate_memory_usage() );
+
+    size_t creature_bytes = g->u.estimate_memory_usage();
+    const size_t num_zombies = g->num_zombies();
+    for( size_t i = 0; i < num_zombies; i++ ) {
+        creature_bytes += g->zombie( i ).estimate_memory_usage();
+    }
+    for( const npc *guy : g->active_npc ) {
+        creature_bytes += guy->estimate_memory_usage();
+    }
+    add( "creatures (reality bubble)", 1 + num_zombies + g->active_npc.size(), creature_bytes );
+
+    size_t item_type_bytes = 0;
+    const auto item_types = item_controller->all();
+    for( const itype *type : item_types ) {
+        item_type_bytes += estimate_itype( *type );
+    }
+    add( "item types", item_types.size(), item_type_bytes );
+
+    size_t monster_type_bytes = 0;
+    const auto &monster_types = MonsterGenerator::generator().get_all_mtypes();
+    for( const mtype &type : monster_types ) {
+        monster_type_bytes += estimate_mtype( type );
+    }
+    add( "monster types", monster_types.size(), monster_type_bytes );
+
+#ifdef TILES
+    if( tilecontext ) {
+        add( "tileset textures", 1, tilecontext->estimate_memory_usage() );
+    }
+#endif
+
+    // Rows are identified by name, the set of rows can differ between builds.
+    static std::map<std::string, size_t> peaks;
+    for( auto &row : result ) {
+        size_t &peak = peaks[row.name];
+        peak = std::max( peak, row.current );
+        row.peak = peak;
+    }
+    return result;
+}
+
+std::string memory_usage::report_text()
+{
+    std::ostringstream out;
+    out << string_format( "%-28s %8s %10s %10s\n", "subsystem", "count", "current", "peak" );
+    format_rows( out, report() );
+    const auto tagged = tagged_allocations();
+    if( !tagged.empty() ) {
+        out << "\n" << string_format( "%-28s %8s %10s %10s\n", "allocations", "blocks", "current",
+                                      "peak" );
+        format_rows( out, tagged );
+    }
+    return out.str();
+}
@@ -0,0 +1,125 @@
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <cstddef>
+#include <map>
+#include <list>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Estimates of the memory used by the major game structures.
+ *
+ * The structures provide an `estimate_memory_usage()` function that returns the size
+ * of the object itself plus the heap memory it owns, the helpers below approximate the
+ * overhead of the standard containers (node sizes of the common implementations).
+ *
+ * @ref report walks the loaded game state and sums the estimates per subsystem. The peak
+ * of each subsystem is the largest value seen by any report so far.
+ *
+ * When compiled with MEMORY_TAGGING defined, the global allocation functions are replaced
+ * and every allocation is attributed to the tag of the innermost active @ref tag_scope.
+ * This gives exact current and peak values per tag at a small cost per allocation.
+ */
+namespace memory_usage
+{
+
+/** Heap memory of a string, zero if it fits into the small string buffer. */
+inline size_t heap_size( const std::string &s )
+{
+    return s.capacity() >= sizeof( std::string ) ? s.capacity() + 1 : 0;
+}
+
+template<typename T>
+inline size_t heap_size( const std::vector<T> &v )
+{
+    return v.capacity() * sizeof( T );
+}
+
+/** Overhead per element of a node based container, on top of the element itself. */
+constexpr size_t list_node_size = 2 * sizeof( void * );
+constexpr size_t tree_node_size = 4 * sizeof( void * );
+constexpr size_t hash_node_size = sizeof( void * ) + sizeof( size_t );
+
+template<typename T>
+inline size_t node_size( const std::list<T> &l )
+{
+    return l.size() * ( list_node_size + sizeof( T ) );
+}
+
+template<typename K, typename V>
+inline size_t node_size( const std::map<K, V> &m )
+{
+    return m.size() * ( tree_node_size + sizeof( std::pair<const K, V> ) );
+}
+
+template<typename K>
+inline size_t node_size( const std::set<K> &s )
+{
+    return s.size() * ( tree_node_size + sizeof( K ) );
+}
+
+template<typename K, typename V, typename H>
+inline size_t node_size( const std::unordered_map<K, V, H> &m )
+{
+    return m.size() * ( hash_node_size + sizeof( std::pair<const K, V> ) ) +
+           m.bucket_count() * sizeof( void * );
+}
+
+inline size_t heap_size( const std::map<std::string, std::string> &m )
+{
+    size_t result = node_size( m );
+    for( const auto &e : m ) {
+        result += heap_size( e.first ) + heap_size( e.second );
+    }
+    return result;
+}
+
+/** Allocation tags, see @ref tag_scope. */
+enum class tag : int {
+    untagged = 0,
+    mapbuffer,
+    overmap,
+    game_data,
+    tiles,
+    num_tags
+};
+
+/**
+ * Attributes all allocations made during the lifetime of this object (on the
+ * current thread) to the given tag. Does nothing unless compiled with MEMORY_TAGGING.
+ */
+class tag_scope
+{
+    public:
+        tag_scope( tag t );
+        ~tag_scope();
+        tag_scope( const tag_scope & ) = delete;
+        tag_scope &operator=( const tag_scope & ) = delete;
+    private:
+        tag previous;
+};
+
+struct subsystem_usage {
+    std::string name;
+    /** Number of objects that were estimated (submaps, overmaps, types...). */
+    size_t count = 0;
+    size_t current = 0;
+    size_t peak = 0;
+};
+
+/** Estimates the memory of all subsystems, updating their peak values. */
+std::vector<subsystem_usage> report();
+/**
+ * Current and peak bytes allocated per tag, empty unless compiled with
+ * MEMORY_TAGGING.
+ */
+std::vector<subsystem_usage> tagged_allocations();
+/** Human readable table of @ref report and @ref tagged_allocations. */
+std::string report_text();
+
+}
+
+#endif
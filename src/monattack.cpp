@@ -21,6 +21,7 @@
 #include "morale_types.h"
 #include "npc.h"
 #include "event.h"
+#include "fake_shooter.h"
 #include "ui.h"
 #include "itype.h"
 #include "vehicle.h"
@@ -156,22 +157,18 @@ bool is_adjacent( const monster *z, const Creature *target, const bool allow_zle
     return g->m.ter( up ) == t_open_air && g->m.is_outside( down );
 }
 
-npc make_fake_npc(monster *z, int str, int dex, int inte, int per) {
-    npc tmp;
-    tmp.name = _("The ") + z->name();
-    tmp.set_fake(true);
-    tmp.recoil = 0;
-    tmp.setpos( z->pos() );
-    tmp.str_cur = str;
-    tmp.dex_cur = dex;
-    tmp.int_cur = inte;
-    tmp.per_cur = per;
-    if( z->friendly != 0 ) {
-        tmp.attitude = NPCATT_FOLLOW;
-    } else {
-        tmp.attitude = NPCATT_KILL;
-    }
-    return tmp;
+/** The shooter for a monster that fires a gun. */
+static shooter_profile fake_shooter_profile( const monster &z, int str, int dex, int inte, int per )
+{
+    shooter_profile profile;
+    profile.name = _( "The " ) + z.name();
+    profile.pos = z.pos();
+    profile.str = str;
+    profile.dex = dex;
+    profile.intl = inte;
+    profile.per = per;
+    profile.friendly = z.friendly != 0;
+    return profile;
 }
 
 bool mattack::none(monster *)
@@ -2714,10 +2711,8 @@ void mattack::rifle( monster *z, Creature *target )
         z->ammo[ammo_type] = 2000;
     }
 
-    npc tmp = make_fake_npc(z, 16, 10, 8, 12);
-    tmp.set_skill_level( skill_rifle, 8 );
-    tmp.set_skill_level( skill_gun, 6 );
-    tmp.recoil = 0; // no need to aim
+    shooter_profile profile = fake_shooter_profile( *z, 16, 10, 8, 12 );
+    profile.skills = { { skill_rifle, 8 }, { skill_gun, 6 } };
 
     if( target == &g->u ) {
         if (!z->has_effect( effect_targeted )) {
@@ -2741,6 +2736,8 @@ void mattack::rifle( monster *z, Creature *target )
         add_msg(m_warning, _("The %s opens up with its rifle!"), z->name().c_str());
     }
 
+    fake_shooter shooter( profile );
+    npc &tmp = *shooter;
     tmp.weapon = item( "m4a1" ).ammo_set( ammo_type, z->ammo[ ammo_type ] );
     int burst = std::max( tmp.weapon.gun_get_mode( "AUTO" ).qty, 1 );
 
@@ -2773,10 +2770,8 @@ void mattack::frag( monster *z, Creature *target ) // This is for the bots, not
             return;
         }
     }
-    npc tmp = make_fake_npc(z, 16, 10, 8, 12);
-    tmp.set_skill_level( skill_launcher, 8 );
-    tmp.set_skill_level( skill_gun, 6 );
-    tmp.recoil = 0; // no need to aim
+    shooter_profile profile = fake_shooter_profile( *z, 16, 10, 8, 12 );
+    profile.skills = { { skill_launcher, 8 }, { skill_gun, 6 } };
     z->moves -= 150;   // It takes a while
 
     if (z->ammo[ammo_type] <= 0) {
@@ -2791,6 +2786,8 @@ void mattack::frag( monster *z, Creature *target ) // This is for the bots, not
         add_msg(m_warning, _("The %s's grenade launcher fires!"), z->name().c_str());
     }
 
+    fake_shooter shooter( profile );
+    npc &tmp = *shooter;
     tmp.weapon = item( "mgl" ).ammo_set( ammo_type, z->ammo[ ammo_type ] );
     int burst = std::max( tmp.weapon.gun_get_mode( "AUTO" ).qty, 1 );
 
@@ -2836,10 +2833,8 @@ void mattack::tankgun( monster *z, Creature *target )
     }
     // kevingranade KA101: yes, but make it really inaccurate
     // Sure thing.
-    npc tmp = make_fake_npc(z, 12, 8, 8, 8);
-    tmp.set_skill_level( skill_launcher, 1 );
-    tmp.set_skill_level( skill_gun, 1 );
-    tmp.recoil = 0; // no need to aim
+    shooter_profile profile = fake_shooter_profile( *z, 12, 8, 8, 8 );
+    profile.skills = { { skill_launcher, 1 }, { skill_gun, 1 } };
     z->moves -= 150;   // It takes a while
 
     if (z->ammo[ammo_type] <= 0) {
@@ -2853,6 +2848,8 @@ void mattack::tankgun( monster *z, Creature *target )
     if (g->u.sees( *z )) {
         add_msg(m_warning, _("The %s's 120mm cannon fires!"), z->name().c_str());
     }
+    fake_shooter shooter( profile );
+    npc &tmp = *shooter;
     tmp.weapon = item( "TANK" ).ammo_set( ammo_type, z->ammo[ ammo_type ] );
     int burst = std::max( tmp.weapon.gun_get_mode( "AUTO" ).qty, 1 );
 
@@ -12,6 +12,7 @@
 #include "item.h"
 #include "translations.h"
 #include "overmapbuffer.h"
+#include "memory_usage.h"
 #include <sstream>
 #include <stdlib.h>
 #include <algorithm>
@@ -1546,6 +1547,16 @@ void monster::explode()
     hp = INT_MIN + 1;
 }
 
+size_t monster::estimate_memory_usage() const
+{
+    size_t result = sizeof( monster ) + Creature::estimate_memory_usage();
+    result += memory_usage::heap_size( inv ) - inv.size() * sizeof( item );
+    for( const auto &it : inv ) {
+        result += it.estimate_memory_usage();
+    }
+    return result;
+}
+
 void monster::process_turn()
 {
     for( const auto &e: type->emit_fields ) {
@@ -1616,7 +1627,7 @@ void monster::die(Creature* nkiller)
         for( int z = 1; z >= -1; --z ) {
             for( int x = -MAPSIZE / 2; x <= MAPSIZE / 2; x++ ) {
                 for( int y = -MAPSIZE / 2; y <= MAPSIZE / 2; y++ ) {
-                    std::vector<mongroup*> groups = overmap_buffer.groups_at( abssub.x + x, abssub.y + y, g->get_levz() + z );
+                    const auto groups = overmap_buffer.groups_at( abssub.x + x, abssub.y + y, g->get_levz() + z );
                     for( auto &mgp : groups ) {
                         if( MonsterGroupManager::IsMonsterInGroup( mgp->type, type->id ) ) {
                             mgp->dying = true;
@@ -316,6 +316,7 @@ class monster : public Creature, public JsonSerializer, public JsonDeserializer
         void disable_special( const std::string &special_name );
 
         void process_turn() override;
+        size_t estimate_memory_usage() const override;
 
         void die( Creature *killer ) override; //this is the die from Creature, it calls kill_mon
         void drop_items_on_death();
@@ -353,6 +354,11 @@ class monster : public Creature, public JsonSerializer, public JsonDeserializer
         // TEMP VALUES
         tripoint wander_pos; // Wander destination - Just try to move in that direction
         int wandf;           // Urge to wander - Increased by sound, decrements each move
+        /**
+         * Turns since the AI of this monster last ran while it is handled at low detail,
+         * -1 while it is handled every turn. See game::monmove.
+         */
+        int ai_deferred_turns = -1;
         std::vector<item> inv; // Inventory
 
         // DEFINING VALUES
@@ -25,6 +25,7 @@
 #include "vehicle.h"
 #include "mtype.h"
 #include "iuse_actor.h"
+#include "memory_usage.h"
 
 #include <algorithm>
 #include <sstream>
@@ -951,6 +952,8 @@ bool npc::wield( item& it )
         }
     }
 
+    invalidate_artifact_cache();
+
     if( it.is_null() ) {
         weapon = ret_null;
         return true;
@@ -1410,8 +1413,7 @@ int npc::value( const item &it, int market_price ) const
     }
 
     int ret = 0;
-    // TODO: Cache own weapon value (it can be a bit expensive to compute 50 times/turn)
-    int weapon_val = weapon_value( it ) - weapon_value( weapon );
+    int weapon_val = cached_weapon_value( it ) - cached_weapon_value( weapon );
     if( weapon_val > 0 ) {
         ret += weapon_val;
     }
@@ -1483,6 +1485,53 @@ int npc::value( const item &it, int market_price ) const
     return ret;
 }
 
+void npc::validate_item_values() const
+{
+    std::vector<int> state = { get_str(), get_dex(), get_per(), get_int() };
+    state.reserve( 8 + _skills.size() + num_bp );
+    for( const auto &elem : _skills ) {
+        state.push_back( elem.second.level() );
+    }
+    for( int i = 0; i < num_bp; i++ ) {
+        state.push_back( encumb( body_part( i ) ) );
+    }
+    // Gun values depend on the volume of the wielded item
+    state.push_back( units::to_milliliter( weapon.volume() ) );
+    state.push_back( std::hash<std::string>()( style_selected.str() ) );
+
+    if( state != item_values.npc_state ) {
+        item_values.npc_state = std::move( state );
+        item_values.values.clear();
+        item_values.version++;
+    }
+}
+
+double npc::cached_weapon_value( const item &weap, long ammo ) const
+{
+    validate_item_values();
+
+    npc_item_value_cache::item_state state;
+    state.type = weap.type;
+    state.ammo = weap.ammo_data();
+    state.damage = weap.damage();
+    state.charges = weap.charges;
+    state.ammo_remaining = weap.ammo_remaining();
+    state.contents = weap.contents.size();
+
+    auto &entry = item_values.values[std::make_pair( &weap, ammo )];
+    if( entry.state.type == nullptr || !( entry.state == state ) ) {
+        entry.state = state;
+        entry.value = weapon_value( weap, ammo );
+    }
+    return entry.value;
+}
+
+int npc::item_values_version() const
+{
+    validate_item_values();
+    return item_values.version;
+}
+
 bool npc::has_healing_item( bool bleed, bool bite, bool infect )
 {
     return !get_healing_item( bleed, bite, infect, true ).is_null();
@@ -2229,6 +2278,11 @@ bool npc::dispose_item( item_location &&obj, const std::string & )
     return true;
 }
 
+size_t npc::estimate_memory_usage() const
+{
+    return player::estimate_memory_usage() - sizeof( player ) + sizeof( npc );
+}
+
 void npc::process_turn()
 {
     player::process_turn();
@@ -246,6 +246,87 @@ struct npc_short_term_cache
     std::vector<npc_target> friends;
 };
 
+/**
+ * Weapon values (see @ref player::weapon_value) of the items the npc has evaluated, keyed
+ * by the address of the item and the amount of ammo.
+ * The values depend on the npc and on the item. Whenever the relevant properties of the npc
+ * (stats, skills, encumbrance, wielded item) change, the version is bumped and all values
+ * are dropped. Each entry remembers the state of its item and is ignored once that changes.
+ */
+struct npc_item_value_cache {
+    /** The properties of the item that go into its value. */
+    struct item_state {
+        const itype *type = nullptr;
+        const itype *ammo = nullptr;
+        int damage = 0;
+        long charges = 0;
+        long ammo_remaining = 0;
+        size_t contents = 0;
+
+        bool operator==( const item_state &rhs ) const {
+            return type == rhs.type && ammo == rhs.ammo && damage == rhs.damage &&
+                   charges == rhs.charges && ammo_remaining == rhs.ammo_remaining && contents == rhs.contents;
+        }
+    };
+
+    struct entry {
+        item_state state;
+        double value;
+    };
+
+    /** Incremented each time the values are dropped because the npc has changed. */
+    int version = 0;
+    /** The properties of the npc the values were computed for. */
+    std::vector<int> npc_state;
+    std::map<std::pair<const item *, long>, entry> values;
+};
+
+/**
+ * The last decision of @ref npc::move and the state of the world it was based on.
+ * Routine decisions (following the player, idling, walking to the destination) are
+ * kept for a few turns instead of running the whole decision tree each turn, until
+ * any of the inputs changes or the plan expires.
+ */
+struct npc_plan {
+    /** The properties of the npc and its surroundings that can change the decision. */
+    struct inputs {
+        int hp = 0;
+        /** One bit for each threshold of hunger, thirst, fatigue and pain that was crossed. */
+        int needs = 0;
+        int attitude = 0;
+        int mission = 0;
+        size_t inventory_size = 0;
+        size_t worn_count = 0;
+        const itype *weapon = nullptr;
+        long weapon_ammo = 0;
+        int player_hp = 0;
+        bool player_asleep = false;
+        bool player_in_vehicle = false;
+        /**
+         * Number of creatures in the reality bubble that could be hostile and the (coarse)
+         * distance to the closest one. This is only based on attitude and distance, it does
+         * not check line of sight.
+         */
+        int hostiles = 0;
+        int closest_hostile = 0;
+
+        bool operator==( const inputs &rhs ) const {
+            return hp == rhs.hp && needs == rhs.needs && attitude == rhs.attitude &&
+                   mission == rhs.mission && inventory_size == rhs.inventory_size &&
+                   worn_count == rhs.worn_count && weapon == rhs.weapon &&
+                   weapon_ammo == rhs.weapon_ammo && player_hp == rhs.player_hp &&
+                   player_asleep == rhs.player_asleep && player_in_vehicle == rhs.player_in_vehicle &&
+                   hostiles == rhs.hostiles && closest_hostile == rhs.closest_hostile;
+        }
+    };
+
+    bool valid = false;
+    npc_action action;
+    /** Turn on which the decision was made. */
+    int turn = 0;
+    inputs state;
+};
+
 // DO NOT USE! This is old, use strings as talk topic instead, e.g. "TALK_AGREE_FOLLOW" instead of
 // TALK_AGREE_FOLLOW. There is also convert_talk_topic which can convert the enumeration values to
 // the new string values (used to load old saves).
@@ -648,6 +729,10 @@ public:
  void update_worst_item_value(); // Find the worst value in our inventory
     int value( const item &it ) const;
     int value( const item &it, int market_price ) const;
+    /** Same as @ref weapon_value, but reuses previous evaluations, see @ref npc_item_value_cache. */
+    double cached_weapon_value( const item &weap, long ammo = 10 ) const;
+    /** Version of the cached weapon values, changes whenever they are dropped. */
+    int item_values_version() const;
     bool wear_if_wanted( const item &it );
     bool wield( item& it ) override;
     bool adjust_worn();
@@ -668,6 +753,10 @@ public:
 
     // AI helpers
     void regen_ai_cache();
+    /** Whether the last decision of @ref move can be repeated without evaluating it again. */
+    bool has_valid_plan() const;
+    /** Forces @ref move to make a new decision on its next call. */
+    void invalidate_plan();
     const Creature *current_target() const;
     Creature *current_target();
 
@@ -695,6 +784,7 @@ public:
  void move(); // Picks an action & a target and calls execute_action
  void execute_action( npc_action action ); // Performs action
     void process_turn() override;
+    size_t estimate_memory_usage() const override;
 
     /** rates how dangerous a target is from 0 (harmless) to 1 (max danger) */
     float evaluate_enemy( const Creature &target ) const;
@@ -833,6 +923,12 @@ private:
     std::map<std::string, int> complaints;
 
     npc_short_term_cache ai_cache;
+    npc_plan plan;
+    npc_plan::inputs plan_inputs() const;
+    mutable npc_item_value_cache item_values;
+
+    /** Drops the cached weapon values if the npc has changed since they were computed. */
+    void validate_item_values() const;
 public:
 
     static npc_map _all_npc;
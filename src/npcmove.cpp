@@ -59,6 +59,8 @@ enum npc_action : int {
 };
 
 const int avoidance_vehicles_radius = 5;
+/** Number of turns after which a kept decision (see @ref npc_plan) is made again anyway. */
+const int npc_plan_lifetime = 10;
 
 std::string npc_action_name(npc_action action);
 
@@ -75,18 +77,19 @@ struct ratio_index {
 
 bool clear_shot_reach( const tripoint &from, const tripoint &to )
 {
-    std::vector<tripoint> path = line_to( from, to );
-    path.pop_back();
-    for( const tripoint &p : path ) {
-        Creature *inter = g->critter_at( p );
-        if( inter != nullptr ) {
+    bool clear = true;
+    bresenham( from, to, 0, 0, [&clear, &to]( const tripoint & p ) {
+        if( p == to ) {
             return false;
-        } else if( g->m.impassable( p ) ) {
+        }
+        if( g->critter_at( p ) != nullptr || g->m.impassable( p ) ) {
+            clear = false;
             return false;
         }
-    }
+        return true;
+    } );
 
-    return true;
+    return clear;
 }
 
 tripoint good_escape_direction( const npc &who )
@@ -254,23 +257,93 @@ void npc::regen_ai_cache()
     ai_cache.target = npc_target::none();
     ai_cache.danger = 0.0f;
     ai_cache.total_danger = 0.0f;
-    ai_cache.my_weapon_value = weapon_value( weapon );
+    ai_cache.my_weapon_value = cached_weapon_value( weapon );
     assess_danger();
 
     choose_target();
 }
 
-void npc::move()
+/** Decisions that only depend on the inputs in @ref npc_plan and have no side effects. */
+static bool is_repeatable_action( npc_action action )
 {
-    regen_ai_cache();
-    npc_action action = npc_undecided;
+    switch( action ) {
+        case npc_pause:
+        case npc_follow_player:
+        case npc_follow_embarked:
+        case npc_goto_destination:
+        case npc_base_idle:
+            return true;
+        default:
+            return false;
+    }
+}
 
-    static const std::string no_target_str = "none";
-    const Creature *target = current_target();
-    const std::string &target_name = target != nullptr ? target->disp_name() : no_target_str;
-    add_msg( m_debug, "NPC %s: target = %s, danger = %.1f, range = %d",
-             name.c_str(), target_name.c_str(), ai_cache.danger, confident_shoot_range( weapon ) );
+npc_plan::inputs npc::plan_inputs() const
+{
+    npc_plan::inputs result;
+    for( int i = 0; i < num_hp_parts; i++ ) {
+        result.hp += hp_cur[i];
+        result.player_hp += g->u.hp_cur[i];
+    }
+    // The thresholds address_needs checks
+    const int hunger = get_hunger();
+    const int thirst = get_thirst();
+    const int fatigue = get_fatigue();
+    result.needs = ( hunger > 40 ) | ( hunger > 160 ) << 1 | ( thirst > 40 ) << 2 |
+                   ( thirst > 80 ) << 3 | ( fatigue >= TIRED ) << 4 |
+                   ( fatigue > MASSIVE_FATIGUE ) << 5 | ( get_perceived_pain() >= 15 ) << 6;
+    result.attitude = attitude;
+    result.mission = mission;
+    result.inventory_size = inv.size();
+    result.worn_count = worn.size();
+    result.weapon = weapon.is_null() ? nullptr : weapon.type;
+    result.weapon_ammo = weapon.ammo_remaining();
+    result.player_asleep = g->u.in_sleep_state();
+    result.player_in_vehicle = g->u.in_vehicle;
+
+    int closest = INT_MAX;
+    const auto add_hostile = [&]( const Creature &critter ) {
+        result.hostiles++;
+        closest = std::min( closest, rl_dist( pos(), critter.pos() ) );
+    };
+    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+        const monster &critter = g->zombie( i );
+        const monster_attitude att = critter.attitude( this );
+        if( !critter.is_dead() && att != MATT_FRIEND && att != MATT_FPASSIVE ) {
+            add_hostile( critter );
+        }
+    }
+    for( const npc *guy : g->active_npc ) {
+        if( guy != this && !guy->is_dead() && attitude_to( *guy ) == A_HOSTILE ) {
+            add_hostile( *guy );
+        }
+    }
+    if( result.hostiles > 0 ) {
+        // Movement of far away creatures does not matter
+        result.closest_hostile = closest <= 10 ? closest : 10 + closest / 5;
+    }
+    return result;
+}
 
+bool npc::has_valid_plan() const
+{
+    if( !plan.valid || calendar::turn.get_turn() - plan.turn >= npc_plan_lifetime ) {
+        return false;
+    }
+    if( plan.action == npc_goto_destination && !path.empty() && !g->is_empty( path.front() ) ) {
+        // Something blocks the way
+        return false;
+    }
+    return plan.state == plan_inputs();
+}
+
+void npc::invalidate_plan()
+{
+    plan.valid = false;
+}
+
+void npc::move()
+{
     //faction opinion determines if it should consider you hostile
     if( !is_enemy() && guaranteed_hostile() && sees( g->u ) ) {
         add_msg( m_debug, "NPC %s turning hostile because is guaranteed_hostile()", name.c_str() );
@@ -281,15 +354,34 @@ void npc::move()
         }
     }
 
+    const bool keep_plan = has_valid_plan();
+    if( !keep_plan ) {
+        regen_ai_cache();
+    }
+    npc_action action = npc_undecided;
+
+    static const std::string no_target_str = "none";
+    const Creature *target = current_target();
+    const std::string &target_name = target != nullptr ? target->disp_name() : no_target_str;
+    add_msg( m_debug, "NPC %s: target = %s, danger = %.1f, range = %d",
+             name.c_str(), target_name.c_str(), ai_cache.danger, confident_shoot_range( weapon ) );
+
     // This bypasses the logic to determine the npc action, but this all needs to be rewritten anyway.
     if( sees_dangerous_field( pos() ) ) {
         const tripoint escape_dir = good_escape_direction( *this );
         if( escape_dir != pos() ) {
+            invalidate_plan();
             move_to( escape_dir );
             return;
         }
     }
 
+    if( keep_plan ) {
+        add_msg( m_debug, "%s keeps action %s.", name.c_str(), npc_action_name( plan.action ).c_str() );
+        execute_action( plan.action );
+        return;
+    }
+
     // TODO: Place player-aiding actions here, with a weight
 
     /* NPCs are fairly suicidal so at this point we will do a quick check to see if
@@ -322,6 +414,7 @@ void npc::move()
                 npc_pause :
                 npc_goto_destination;
         } else if( has_new_items && scan_new_items() ) {
+            invalidate_plan();
             return;
         } else if( !fetching_item ) {
             find_item();
@@ -364,6 +457,18 @@ void npc::move()
 
     add_msg( m_debug, "%s chose action %s.", name.c_str(), npc_action_name( action ).c_str() );
 
+    // Only routine decisions are kept, anything involving a target, items or
+    // attitudes with side effects (see address_player) is made every turn.
+    plan.valid = is_repeatable_action( action ) && current_target() == nullptr &&
+                 ai_cache.danger <= 0 && !is_enemy() && !has_new_items && !fetching_item &&
+                 attitude != NPCATT_TALK && attitude != NPCATT_MUG && attitude != NPCATT_LEAD &&
+                 attitude != NPCATT_WAIT_FOR_LEAVE && attitude != NPCATT_FLEE;
+    if( plan.valid ) {
+        plan.action = action;
+        plan.turn = calendar::turn.get_turn();
+        plan.state = plan_inputs();
+    }
+
     execute_action( action );
 }
 
@@ -2249,7 +2354,7 @@ bool npc::wield_better_weapon()
         bool allowed = can_use_gun && it.is_gun() && ( !use_silent || it.is_silent() );
         double val;
         if( !allowed ) {
-            val = weapon_value( it, 0 );
+            val = cached_weapon_value( it, 0 );
         } else {
             long ammo_count = it.ammo_remaining();
             long ups_drain = it.get_gun_ups_drain();
@@ -2257,7 +2362,7 @@ bool npc::wield_better_weapon()
                 ammo_count = std::min( ammo_count, ups_charges / ups_drain );
             }
 
-            val = weapon_value( it, ammo_count );
+            val = cached_weapon_value( it, ammo_count );
         }
 
         if( val > best_value ) {
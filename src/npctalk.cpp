@@ -572,6 +572,8 @@ void npc::talk_to_u()
     } while (!d.done);
     delwin(d.win);
     g->refresh_all();
+    // The conversation may have changed rules or goals that the last decision depended on
+    invalidate_plan();
     // Don't query if we're training the player
     if( g->u.activity.id() != activity_id( "ACT_TRAIN" ) || g->u.activity.index != getID() ) {
         g->cancel_activity_query( _("%s talked to you."), name.c_str() );
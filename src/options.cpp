@@ -12,6 +12,7 @@
 #include "worldfactory.h"
 #include "catacharset.h"
 #include "game_constants.h"
+#include "recipe_dictionary.h"
 
 #ifdef TILES
 #include "cata_tiles.h"
@@ -873,6 +874,11 @@ void options_manager::init()
         0, 127, 5
         );
 
+    add("SAVE_COMPRESSION", "general", _("Compress save files"),
+        _("If true, map, overmap and character save files are written compressed. Saves written with or without compression can always be loaded."),
+        false
+        );
+
     mOptionsSort["general"]++;
 
     add("CIRCLEDIST", "general", _("Circular distances"),
@@ -1277,6 +1283,18 @@ void options_manager::init()
 
     mOptionsSort["debug"]++;
 
+    add("MONSTER_AI_LOD_DISTANCE", "debug", _("Monster AI detail distance"),
+        _("Monsters further than this from you and any NPC, or wandering out of your sight at more than half of this distance, only think and move every few turns. See option 'Monster AI low detail interval'."),
+        1, 60, 40
+        );
+
+    add("MONSTER_AI_LOD_INTERVAL", "debug", _("Monster AI low detail interval"),
+        _("Number of turns between the moves of monsters far from anything interesting. They catch up on the moves they skipped when they are processed. 1 processes every monster every turn."),
+        1, 10, 4
+        );
+
+    mOptionsSort["debug"]++;
+
     add("FOV_3D", "debug", _("Experimental 3D Field of Vision"),
         _("If false, vision is limited to current z-level. If true and the world is in z-level mode, the vision will extend beyond current z-level. Currently very bugged!"),
         false
@@ -1871,6 +1889,8 @@ void options_manager::show(bool ingame)
     }
     if( lang_changed ) {
         set_language(false);
+        // Searches compare against translated names
+        recipe_dictionary::build_search_index();
     }
 
     refresh_tiles( used_tiles_changed, pixel_minimap_height_changed, ingame );
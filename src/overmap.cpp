@@ -32,6 +32,7 @@
 #include "mapbuffer.h"
 #include "map_iterator.h"
 #include "messages.h"
+#include "memory_usage.h"
 
 #include <cassert>
 #include <stdlib.h>
@@ -42,6 +43,8 @@
 #include <cstring>
 #include <ostream>
 #include <algorithm>
+#include <climits>
+#include <functional>
 #include <numeric>
 
 #define dbg(x) DebugLog((DebugLevel)(x),D_MAP_GEN) << __FILE__ << ":" << __LINE__ << ": "
@@ -342,6 +345,61 @@ bool road_allowed(const oter_id &ter)
     return ter->has_flag( allow_road );
 }
 
+namespace
+{
+
+/**
+ * Caches a predicate on terrains. Generating an overmap checks the terrain type of
+ * every tile several times and comparing the ids as strings each time is too slow.
+ */
+class oter_matcher
+{
+    public:
+        oter_matcher( std::function<bool( const oter_id & )> pred ) : pred( std::move( pred ) ) {}
+
+        bool operator()( const oter_id &oter ) {
+            const size_t i = oter.to_i();
+            if( i >= cache.size() ) {
+                cache.resize( i + 1, unknown );
+            }
+            if( cache[i] == unknown ) {
+                cache[i] = pred( oter ) ? matches : differs;
+            }
+            return cache[i] == matches;
+        }
+
+    private:
+        enum : char { unknown, matches, differs };
+
+        std::function<bool( const oter_id & )> pred;
+        std::vector<char> cache;
+};
+
+/** Whether a road, sewer etc. of type @p otype connects to terrain @p oter. */
+bool connects_to( const std::string &otype, const oter_id &oter )
+{
+    if( otype == "road" || otype == "bridge" || otype == "hiway" ) {
+        return is_ot_type( "road", oter ) || is_ot_type( "bridge", oter ) || is_ot_type( "hiway", oter );
+    }
+    return is_ot_type( otype, oter );
+}
+
+/** Flags of @ref overmap::connection_grid. */
+enum connection_tile : unsigned char {
+    connection_blocked = 1,  // Connections can't cross it (e.g. buildings)
+    connection_river = 2,
+    connection_existing = 4, // Already a connection of the same type
+};
+
+unsigned char connection_flags( const oter_id &oter, oter_matcher &is_base )
+{
+    return ( road_allowed( oter ) ? 0 : connection_blocked ) |
+           ( is_river( oter ) ? connection_river : 0 ) |
+           ( is_base( oter ) ? connection_existing : 0 );
+}
+
+}
+
 oter_id overmap::random_shop() const
 {
     return settings.city_spec.pick_shop();
@@ -1262,6 +1320,39 @@ void overmap::add_npc( npc &who )
     g->set_npcs_dirty();
 }
 
+size_t overmap::estimate_memory_usage() const
+{
+    using namespace memory_usage;
+    size_t result = sizeof( overmap );
+    for( const auto &l : layer ) {
+        result += heap_size( l.notes );
+        for( const auto &n : l.notes ) {
+            result += heap_size( n.text );
+        }
+    }
+    result += zg.size() * ( tree_node_size + sizeof( std::pair<const tripoint, mongroup> ) );
+    for( const auto &grp : zg ) {
+        result += heap_size( grp.second.monsters ) - grp.second.monsters.size() * sizeof( monster );
+        for( const auto &critter : grp.second.monsters ) {
+            result += critter.estimate_memory_usage();
+        }
+        result += heap_size( grp.second.horde_behaviour );
+    }
+    result += node_size( scents );
+    result += monster_map.size() * ( hash_node_size + sizeof( std::pair<const tripoint, monster> ) -
+                                     sizeof( monster ) ) + monster_map.bucket_count() * sizeof( void * );
+    for( const auto &m : monster_map ) {
+        result += m.second.estimate_memory_usage();
+    }
+    result += heap_size( npcs );
+    for( const npc *guy : npcs ) {
+        result += guy->estimate_memory_usage();
+    }
+    result += heap_size( radios ) + heap_size( cities ) + heap_size( roads_out );
+    result += node_size( vehicles );
+    return result;
+}
+
 bool overmap::has_note(int const x, int const y, int const z) const
 {
     if (z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT) {
@@ -1996,7 +2087,7 @@ void overmap::draw(WINDOW *w, WINDOW *wbar, const tripoint &center,
 
     // If we're debugging monster groups, find the monster group we've selected
     const mongroup *mgroup = nullptr;
-    std::vector<mongroup *> mgroups;
+    scratch_vector<mongroup *> mgroups;
     if(data.debug_mongroup) {
         mgroups = overmap_buffer.monsters_at( center.x, center.y, center.z );
         for( const auto &mgp : mgroups ) {
@@ -3564,28 +3655,41 @@ void overmap::place_rifts(int const z)
     }
 }
 
-void overmap::make_hiway( int x1, int y1, int x2, int y2, int z, const std::string &base )
+std::vector<unsigned char> overmap::connection_grid( const int z, const std::string &base ) const
+{
+    oter_matcher is_base( [&base]( const oter_id & oter ) {
+        return is_ot_type( base, oter );
+    } );
+    std::vector<unsigned char> grid( OMAPX * OMAPY );
+    for( int y = 0; y < OMAPY; y++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            grid[y * OMAPX + x] = connection_flags( get_ter( x, y, z ), is_base );
+        }
+    }
+    return grid;
+}
+
+void overmap::make_hiway( std::vector<unsigned char> &grid, const tripoint &source,
+                          const tripoint &dest, const std::string &base )
 {
-    const tripoint source( x1, y1, z );
-    const tripoint dest( x2, y2, z );
     const int disp = base == "road" ? 5 : 2;
 
-    const auto estimate = [ this, disp, &base, &dest ]( const pf::node &prev, const pf::node &cur ) {
+    const auto estimate = [ &grid, disp, &dest ]( const pf::node &prev, const pf::node &cur ) {
+        const unsigned char tile = grid[cur.y * OMAPX + cur.x];
         // Reject nodes that don't allow roads to cross them (e.g. buildings)
-        if( !road_allowed( ter( cur.x, cur.y, dest.z ) ) ) {
+        if( tile & connection_blocked ) {
             return -1;
         }
         // Reject nodes that make corners on the river
-        if( prev.dir != cur.dir && ( is_river( ter( prev.x, prev.y, dest.z ) ) ||
-                                     is_river( ter( cur.x, cur.y, dest.z ) ) ) ) {
+        if( prev.dir != cur.dir && ( ( grid[prev.y * OMAPX + prev.x] | tile ) & connection_river ) ) {
             return -1;
         }
 
         int res = ( std::abs( dest.x - cur.x ) + std::abs( dest.y - cur.y ) ) / disp;
         // Prefer existing roads.
-        res += check_ot_type( base, cur.x, cur.y, dest.z ) ? 0 : 3;
+        res += tile & connection_existing ? 0 : 3;
         // Prefer flat land over bridges
-        res += !is_river( ter( cur.x, cur.y, dest.z ) ) ? 0 : 2;
+        res += tile & connection_river ? 2 : 0;
         // Try not to turn too much
         //res += (mn.d == d) ? 0 : 1;
         return res;
@@ -3595,35 +3699,80 @@ void overmap::make_hiway( int x1, int y1, int x2, int y2, int z, const std::stri
     const oter_id bridge_ew( "bridge_ew" );
     const oter_id base_nesw( base + "_nesw" );
 
+    oter_matcher is_base( [&base]( const oter_id & oter ) {
+        return is_ot_type( base, oter );
+    } );
+
     for( const auto &node : pf::find_path( source, dest, OMAPX, OMAPY, estimate ) ) {
-        auto &id = ter( node.x, node.y, z );
+        auto &id = ter( node.x, node.y, dest.z );
 
         if( is_river( id ) ) {
             id = node.dir == 1 || node.dir == 3 ? bridge_ns : bridge_ew;
         } else {
             id = base_nesw;
         }
+        grid[node.y * OMAPX + node.x] = connection_flags( id, is_base );
     }
 }
 
+void overmap::make_hiway( int x1, int y1, int x2, int y2, int z, const std::string &base )
+{
+    std::vector<unsigned char> grid = connection_grid( z, base );
+    make_hiway( grid, tripoint( x1, y1, z ), tripoint( x2, y2, z ), base );
+}
+
 void overmap::place_hiways( const std::vector<city> &cities, int z, const std::string &base )
 {
-    if (cities.size() == 1) {
+    if( cities.size() < 2 ) {
         return;
     }
-    city best;
-    for (size_t i = 0; i < cities.size(); i++) {
-        int closest = -1;
-        for (size_t j = i + 1; j < cities.size(); j++) {
-            int distance = trig_dist(cities[i].x, cities[i].y, cities[j].x, cities[j].y);
-            if (distance < closest || closest < 0) {
-                closest = distance;
-                best = cities[j];
+    std::vector<unsigned char> grid = connection_grid( z, base );
+
+    // Connect the points along a minimum spanning tree (Prim's algorithm): each point is
+    // connected to the closest point that is already part of the network. The paths
+    // prefer existing connections, so later ones join and share the earlier corridors.
+    // A path does not change the terrain at its destination and can't end on the border
+    // of the overmap, so points on the border (e.g. roads out) only ever start paths.
+    const auto on_border = [&cities]( const size_t i ) {
+        return cities[i].x <= 0 || cities[i].y <= 0 || cities[i].x >= OMAPX - 1 ||
+               cities[i].y >= OMAPY - 1;
+    };
+    size_t root = cities.size() - 1;
+    while( root > 0 && on_border( root ) ) {
+        root--;
+    }
+    const bool all_on_border = on_border( root );
+
+    std::vector<bool> connected( cities.size(), false );
+    std::vector<int> closest( cities.size(), INT_MAX );
+    std::vector<size_t> parent( cities.size(), root );
+    size_t cur = root;
+    for( size_t n = 0; n < cities.size(); n++ ) {
+        connected[cur] = true;
+        if( n > 0 ) {
+            const city &from = cities[cur];
+            const city &to = cities[parent[cur]];
+            make_hiway( grid, tripoint( from.x, from.y, z ), tripoint( to.x, to.y, z ), base );
+        }
+
+        const bool can_be_parent = all_on_border || !on_border( cur );
+        size_t next = cur;
+        for( size_t i = 0; i < cities.size(); i++ ) {
+            if( connected[i] ) {
+                continue;
+            }
+            if( can_be_parent ) {
+                const int distance = trig_dist( cities[cur].x, cities[cur].y, cities[i].x, cities[i].y );
+                if( distance < closest[i] ) {
+                    closest[i] = distance;
+                    parent[i] = cur;
+                }
+            }
+            if( next == cur || closest[i] < closest[next] ) {
+                next = i;
             }
         }
-        if( closest > 0 ) {
-            make_hiway(cities[i].x, cities[i].y, best.x, best.y, z, base);
-        }
+        cur = next;
     }
 }
 
@@ -3647,6 +3796,32 @@ void overmap::polish(const int z, const std::string &terrain_type)
         return ter.type_is( bridge_ns_type ) || ter.type_is( bridge_ew_type );
     };
 
+    oter_matcher is_river_type( []( const oter_id & oter ) {
+        return is_ot_type( "river", oter );
+    } );
+    // What each type of line drawn terrain connects to, by type
+    std::map<const oter_type_t *, oter_matcher> connections;
+    const auto good_road = [&]( const oter_type_t &type, const int x, const int y ) {
+        auto iter = connections.find( &type );
+        if( iter == connections.end() ) {
+            const std::string otype = type.id.str();
+            iter = connections.emplace( &type, oter_matcher( [otype]( const oter_id & oter ) {
+                return connects_to( otype, oter );
+            } ) ).first;
+        }
+        std::bitset<om_direction::size> compass;
+        for( auto dir : om_direction::all ) {
+            const point p( om_direction::displace( dir ) );
+            if( iter->second( ter( x + p.x, y + p.y, z ) ) ) {
+                compass.set( static_cast<int>( dir ) );
+            }
+        }
+        if( compass.none() ) {
+            compass.set(); // No adjoining roads/etc. Happens occasionally, esp. with sewers.
+        }
+        return type.get_linear( compass.to_ulong() - 1 );
+    };
+
     // Main loop--checks roads and rivers that aren't on the borders of the map
     for (int x = 0; x < OMAPX; x++) {
         for (int y = 0; y < OMAPY; y++) {
@@ -3655,7 +3830,7 @@ void overmap::polish(const int z, const std::string &terrain_type)
 
             if( check_all || oter_obj.type_is( target_type ) ) {
                 if( oter_obj.has_flag( line_drawing ) ) {
-                    oter = good_road( *oter_obj.type, x, y, z );
+                    oter = good_road( *oter_obj.type, x, y );
 
                     if( one_in( 4 ) && oter == road_nesw ) {
                         oter = road_mahole;
@@ -3676,9 +3851,9 @@ void overmap::polish(const int z, const std::string &terrain_type)
                         // So, fix it by making that square normal road;
                         // also taking other road pieces that may be next
                         // to it into account. A bit of a kludge but it works.
-                        oter = good_road( road_type, x, y, z );
+                        oter = good_road( road_type, x, y );
                     }
-                } else if( is_ot_type( "river", oter ) ) {
+                } else if( is_river_type( oter ) ) {
                     good_river(x, y, z);
                 }
             }
@@ -3695,28 +3870,34 @@ void overmap::polish(const int z, const std::string &terrain_type)
     // This can actually be a good thing; it ensures nice connections
     // Also, this leaves, say, 3x3 areas of road.
     // TODO: fix this?  courtyards etc?
+    const oter_id road_nes( "road_nes" );
+    const oter_id road_nsw( "road_nsw" );
+    const oter_id road_esw( "road_esw" );
+    const oter_id road_new( "road_new" );
+    const oter_id hiway_ns( "hiway_ns" );
+    const oter_id hiway_ew( "hiway_ew" );
     for (int y = 0; y < OMAPY - 1; y++) {
         for (int x = 0; x < OMAPX - 1; x++) {
             auto &oter = ter( x, y, z );
             auto &oter_obj = *oter;
 
             if( check_all || oter_obj.type_is( target_type ) ) {
-                if ( oter == "road_nes"
-                    && ter(x + 1, y, z) == "road_nsw"
-                    && ter(x, y + 1, z) == "road_nes"
-                    && ter(x + 1, y + 1, z) == "road_nsw") {
-                    oter = oter_id( "hiway_ns" );
-                    ter(x + 1, y, z) = oter_id( "hiway_ns" );
-                    ter(x, y + 1, z) = oter_id( "hiway_ns" );
-                    ter(x + 1, y + 1, z) = oter_id( "hiway_ns" );
-                } else if ( oter == "road_esw"
-                           && ter(x + 1, y, z) == "road_esw"
-                           && ter(x, y + 1, z) == "road_new"
-                           && ter(x + 1, y + 1, z) == "road_new" ) {
-                    oter = oter_id( "hiway_ew" );
-                    ter(x + 1, y, z) = oter_id( "hiway_ew" );
-                    ter(x, y + 1, z) = oter_id( "hiway_ew" );
-                    ter(x + 1, y + 1, z) = oter_id( "hiway_ew" );
+                if ( oter == road_nes
+                    && ter(x + 1, y, z) == road_nsw
+                    && ter(x, y + 1, z) == road_nes
+                    && ter(x + 1, y + 1, z) == road_nsw) {
+                    oter = hiway_ns;
+                    ter(x + 1, y, z) = hiway_ns;
+                    ter(x, y + 1, z) = hiway_ns;
+                    ter(x + 1, y + 1, z) = hiway_ns;
+                } else if ( oter == road_esw
+                           && ter(x + 1, y, z) == road_esw
+                           && ter(x, y + 1, z) == road_new
+                           && ter(x + 1, y + 1, z) == road_new ) {
+                    oter = hiway_ew;
+                    ter(x + 1, y, z) = hiway_ew;
+                    ter(x, y + 1, z) = hiway_ew;
+                    ter(x + 1, y + 1, z) = hiway_ew;
                 }
             }
         }
@@ -3752,21 +3933,6 @@ bool overmap::check_ot_type(const std::string &otype, int x, int y, int z) const
     return is_ot_type(otype, oter);
 }
 
-bool overmap::check_ot_type_road(const std::string &otype, int x, int y, int z)
-{
-    const oter_id oter = ter(x, y, z);
-    if(otype == "road" || otype == "bridge" || otype == "hiway") {
-        if(is_ot_type("road", oter) || is_ot_type ("bridge", oter) || is_ot_type("hiway", oter)) {
-            return true;
-        } else {
-            return false;
-        }
-    }
-    return is_ot_type(otype, oter);
-}
-
-
-
 bool overmap::is_road(int x, int y, int z)
 {
     if( !inbounds( x, y, z ) ) {
@@ -3780,24 +3946,6 @@ bool overmap::is_road(int x, int y, int z)
     //oter_t(ter(x, y, z)).is_road;
 }
 
-oter_id overmap::good_road( const oter_type_t &type, int x, int y, int z )
-{
-    std::bitset<om_direction::size> compass;
-
-    for( auto dir : om_direction::all ) {
-        const point p( om_direction::displace( dir ) );
-        if( check_ot_type_road( type.id.str(), x + p.x, y + p.y, z ) ) {
-            compass.set( static_cast<int>( dir ) );
-        }
-    }
-
-    if( compass.none() ) {
-        compass.set(); // No adjoining roads/etc. Happens occasionally, esp. with sewers.
-    }
-
-    return type.get_linear( compass.to_ulong() - 1 );
-}
-
 void overmap::good_river(int x, int y, int z)
 {
     if((x == 0) || (x == OMAPX-1)) {
@@ -4146,6 +4294,269 @@ std::vector<point> overmap::get_sectors() const
     return res;
 }
 
+namespace
+{
+
+/**
+ * Spatial index of the cities of an overmap. Gives the same result as
+ * overmap::get_nearest_city (ties go to the city listed first), but only looks at
+ * the cities in the buckets around the point.
+ */
+class city_index
+{
+    public:
+        city_index( const std::vector<city> &cities ) : cities( cities ), buckets( cells_x * cells_y ) {
+            for( size_t i = 0; i < cities.size(); ++i ) {
+                const city &c = cities[i];
+                max_size = std::max( max_size, c.s );
+                if( c.x < 0 || c.x >= OMAPX || c.y < 0 || c.y >= OMAPY ) {
+                    outside.push_back( i ); // Always checked, the bucket bounds don't hold for them.
+                } else {
+                    buckets[( c.y / cell_size ) * cells_x + c.x / cell_size].push_back( i );
+                }
+            }
+        }
+
+        const city &nearest( const tripoint &p ) const {
+            int distance = 999;
+            size_t res = cities.size();
+            const auto check = [ & ]( size_t index ) {
+                const int dist = cities[index].get_distance_from( p );
+                if( dist < distance || ( dist == distance && index < res ) ) {
+                    distance = dist;
+                    res = index;
+                }
+            };
+            for( const size_t index : outside ) {
+                check( index );
+            }
+
+            const int px = std::min( std::max( p.x, 0 ), OMAPX - 1 ) / cell_size;
+            const int py = std::min( std::max( p.y, 0 ), OMAPY - 1 ) / cell_size;
+            const int max_ring = cells_x > cells_y ? cells_x : cells_y;
+            for( int ring = 0; ring < max_ring; ++ring ) {
+                for( int cy = py - ring; cy <= py + ring; ++cy ) {
+                    for( int cx = px - ring; cx <= px + ring; ++cx ) {
+                        const bool on_ring = std::abs( cx - px ) == ring || std::abs( cy - py ) == ring;
+                        if( !on_ring || cx < 0 || cx >= cells_x || cy < 0 || cy >= cells_y ) {
+                            continue;
+                        }
+                        for( const size_t index : buckets[cy * cells_x + cx] ) {
+                            check( index );
+                        }
+                    }
+                }
+                // Cities in the next rings are at least this far away.
+                if( res != cities.size() && distance < ring * cell_size + 1 - max_size ) {
+                    break;
+                }
+            }
+
+            if( res != cities.size() ) {
+                return cities[res];
+            }
+            static city invalid_city;
+            return invalid_city;
+        }
+
+    private:
+        static constexpr int cell_size = OMSPEC_FREQ;
+        static constexpr int cells_x = ( OMAPX + cell_size - 1 ) / cell_size;
+        static constexpr int cells_y = ( OMAPY + cell_size - 1 ) / cell_size;
+
+        const std::vector<city> &cities;
+        std::vector<std::vector<size_t>> buckets;
+        std::vector<size_t> outside;
+        int max_size = 0;
+};
+
+/** Footprint of a special in one rotation, relative to the placement point. */
+struct special_footprint {
+    std::vector<point> surface;  // Terrains on z-level 0, they are tested against the locations.
+    point min;                   // Bounding box of all the terrains.
+    point max;
+    point surface_min;           // Bounding box of the surface terrains.
+    point surface_max;
+    bool rectangular = false;    // The surface terrains fill their bounding box.
+};
+
+/** Data shared by all the sectors while placing the specials of an overmap. */
+struct special_placement_cache {
+    using locations_t = std::set<const overmap_special_location *>;
+    /** Location test results per oter id. */
+    std::map<locations_t, std::vector<char>> tests;
+    /** Footprints in all the allowed rotations, empty if the special can't be placed at all. */
+    std::map<const overmap_special *, std::vector<special_footprint>> footprints;
+    /** Largest distance of a terrain of any special from its placement point. */
+    int reach = 0;
+};
+
+/**
+ * Where the specials fit in one sector of the overmap. The location tests of the terrain around
+ * the sector are evaluated once into masks with summed-area tables, so a footprint can be
+ * tested with a few lookups instead of checking each terrain on each try.
+ * Placing a special changes the terrain, the area must not be used after that.
+ */
+class special_placement_area
+{
+    public:
+        using locations_t = special_placement_cache::locations_t;
+
+        special_placement_area( const overmap &om, const point &sector, special_placement_cache &cache ) :
+            om( om ), sector( sector ), cache( cache ),
+            origin( sector.x - cache.reach, sector.y - cache.reach ),
+            width( OMSPEC_FREQ + 2 * cache.reach ), height( OMSPEC_FREQ + 2 * cache.reach ) {}
+
+        /** Whether the terrains of the special fit at the point (of this sector) in any rotation. */
+        bool fits( const overmap_special &special, const tripoint &p ) {
+            const std::vector<special_footprint> &footprints = get_footprints( special );
+            if( footprints.empty() ) {
+                return false;
+            }
+            const std::vector<int> &sums = get_sums( special.locations );
+            return std::any_of( footprints.begin(), footprints.end(),
+            [ this, &sums, &p ]( const special_footprint &fp ) {
+                return fits_at( fp, sums, p.x, p.y );
+            } );
+        }
+
+        /** Positions in the sector where the special fits in at least one rotation. */
+        const std::vector<tripoint> &fitting_positions( const overmap_special &special ) {
+            const auto iter = positions.find( &special );
+            if( iter != positions.end() ) {
+                return iter->second;
+            }
+            std::vector<tripoint> &res = positions[&special];
+            for( int y = sector.y; y < sector.y + OMSPEC_FREQ; ++y ) {
+                for( int x = sector.x; x < sector.x + OMSPEC_FREQ; ++x ) {
+                    if( fits( special, tripoint( x, y, 0 ) ) ) {
+                        res.emplace_back( x, y, 0 );
+                    }
+                }
+            }
+            return res;
+        }
+
+    private:
+        const overmap &om;
+        const point sector;
+        special_placement_cache &cache;
+        /** The window of the overmap covered by the masks. */
+        const point origin;
+        const int width;
+        const int height;
+
+        std::map<locations_t, std::vector<int>> sums_by_locations;
+        std::map<const overmap_special *, std::vector<tripoint>> positions;
+
+        const std::vector<special_footprint> &get_footprints( const overmap_special &special ) {
+            const auto iter = cache.footprints.find( &special );
+            if( iter != cache.footprints.end() ) {
+                return iter->second;
+            }
+            std::vector<special_footprint> &res = cache.footprints[&special];
+            for( const auto &elem : special.terrains ) {
+                if( elem.p.z < -OVERMAP_DEPTH || elem.p.z > OVERMAP_HEIGHT ) {
+                    return res; // Can't be placed anywhere.
+                }
+            }
+            for( auto r : om_direction::all ) {
+                special_footprint fp;
+                fp.min = fp.surface_min = point( INT_MAX, INT_MAX );
+                fp.max = fp.surface_max = point( INT_MIN, INT_MIN );
+                for( const auto &elem : special.terrains ) {
+                    const tripoint rp = om_direction::rotate( elem.p, r );
+                    fp.min = point( std::min( fp.min.x, rp.x ), std::min( fp.min.y, rp.y ) );
+                    fp.max = point( std::max( fp.max.x, rp.x ), std::max( fp.max.y, rp.y ) );
+                    if( rp.z == 0 ) {
+                        fp.surface.emplace_back( rp.x, rp.y );
+                        fp.surface_min = point( std::min( fp.surface_min.x, rp.x ), std::min( fp.surface_min.y, rp.y ) );
+                        fp.surface_max = point( std::max( fp.surface_max.x, rp.x ), std::max( fp.surface_max.y, rp.y ) );
+                    }
+                }
+                if( !fp.surface.empty() ) {
+                    std::sort( fp.surface.begin(), fp.surface.end() );
+                    fp.surface.erase( std::unique( fp.surface.begin(), fp.surface.end() ), fp.surface.end() );
+                    fp.rectangular = int( fp.surface.size() ) == area( fp.surface_min, fp.surface_max );
+                }
+                res.push_back( fp );
+                if( !special.rotatable ) {
+                    break;
+                }
+            }
+            return res;
+        }
+
+        static int area( const point &min, const point &max ) {
+            return ( max.x - min.x + 1 ) * ( max.y - min.y + 1 );
+        }
+
+        static bool test_location( std::vector<char> &tests, const locations_t &locations, const oter_id &oter ) {
+            const size_t index = oter.to_i();
+            if( index >= tests.size() ) {
+                tests.resize( index + 1, -1 );
+            }
+            if( tests[index] < 0 ) {
+                tests[index] = std::any_of( locations.begin(), locations.end(),
+                [ &oter ]( const overmap_special_location *loc ) {
+                    return loc->test( oter );
+                } );
+            }
+            return tests[index] != 0;
+        }
+
+        /** Summed-area table of the tiles of the window that pass the location test. */
+        const std::vector<int> &get_sums( const locations_t &locations ) {
+            const auto iter = sums_by_locations.find( locations );
+            if( iter != sums_by_locations.end() ) {
+                return iter->second;
+            }
+            std::vector<int> &sums = sums_by_locations[locations];
+            std::vector<char> &tests = cache.tests[locations];
+            sums.assign( ( width + 1 ) * ( height + 1 ), 0 );
+            for( int y = 0; y < height; ++y ) {
+                int row = 0;
+                for( int x = 0; x < width; ++x ) {
+                    const int ox = origin.x + x;
+                    const int oy = origin.y + y;
+                    if( ox >= 0 && ox < OMAPX && oy >= 0 && oy < OMAPY &&
+                        test_location( tests, locations, om.get_ter( ox, oy, 0 ) ) ) {
+                        row++;
+                    }
+                    sums[( y + 1 ) * ( width + 1 ) + x + 1] = sums[y * ( width + 1 ) + x + 1] + row;
+                }
+            }
+            return sums;
+        }
+
+        /** Number of tiles passing the test in the rectangle, in overmap coordinates. */
+        int count( const std::vector<int> &sums, int x1, int y1, int x2, int y2 ) const {
+            x1 -= origin.x;
+            x2 -= origin.x - 1;
+            y1 -= origin.y;
+            y2 -= origin.y - 1;
+            return sums[y2 * ( width + 1 ) + x2] - sums[y1 * ( width + 1 ) + x2] -
+                   sums[y2 * ( width + 1 ) + x1] + sums[y1 * ( width + 1 ) + x1];
+        }
+
+        bool fits_at( const special_footprint &fp, const std::vector<int> &sums, int x, int y ) const {
+            // All the terrains must be in bounds, see overmap::inbounds( p, 1 ).
+            if( x + fp.min.x < 1 || x + fp.max.x >= OMAPX - 1 ||
+                y + fp.min.y < 1 || y + fp.max.y >= OMAPY - 1 ) {
+                return false;
+            }
+            if( fp.rectangular ) {
+                return count( sums, x + fp.surface_min.x, y + fp.surface_min.y,
+                              x + fp.surface_max.x, y + fp.surface_max.y ) == area( fp.surface_min, fp.surface_max );
+            }
+            return std::all_of( fp.surface.begin(), fp.surface.end(), [ this, &sums, x, y ]( const point &p ) {
+                return count( sums, x + p.x, y + p.y, x + p.x, y + p.y ) == 1;
+            } );
+        }
+};
+
+}
+
 // should work essentially the same as previously
 // split map into sections, iterate through sections
 // iterate through specials, check if special is valid
@@ -4195,8 +4606,20 @@ void overmap::place_specials()
     // Make random permutations.
     std::random_shuffle( mandatory.begin(), mandatory.end() );
     std::random_shuffle( optional.begin(), optional.end() );
+    // The masks of a sector must cover the footprints of the specials placed at its edges.
+    special_placement_cache cache;
+    for( const auto *list : { &mandatory, &optional } ) {
+        for( const auto &elem : *list ) {
+            for( const auto &ter : elem.first->terrains ) {
+                cache.reach = std::max( { cache.reach, std::abs( ter.p.x ), std::abs( ter.p.y ) } );
+            }
+        }
+    }
+    const city_index nearest_cities( cities );
+    const std::vector<point> sectors = get_sectors();
     // Walk over sectors.
-    for( const point &sector : get_sectors() ) {
+    for( const point &sector : sectors ) {
+        special_placement_area area( *this, sector, cache );
         const int x = sector.x;
         const int y = sector.y;
         // Try to place mandatory specials first.
@@ -4206,7 +4629,7 @@ void overmap::place_specials()
 
         for( size_t i = 0; i < attempts; ++i ) {
             const tripoint p( rng( x, x + OMSPEC_FREQ - 1 ), rng( y, y + OMSPEC_FREQ - 1 ), 0 );
-            const city &nearest_city = get_nearest_city( p );
+            const city &nearest_city = nearest_cities.nearest( p );
 
             auto &candidates = optional.empty() || ( !mandatory.empty() && i < attempts_mandatory ) ? mandatory : optional;
 
@@ -4216,6 +4639,10 @@ void overmap::place_specials()
                 if( !special.can_belong_to_city( p, nearest_city ) ) {
                     continue;
                 }
+                // The masks rule out most of the remaining specials.
+                if( !area.fits( special, p ) ) {
+                    continue;
+                }
                 // See if we can actually place the special there.
                 const auto rotation = random_special_rotation( special, p );
                 if( rotation == om_direction::type::invalid ) {
@@ -4237,6 +4664,42 @@ void overmap::place_specials()
             }
         }
     }
+    // Random points rarely suit specials with strict requirements. Mandatory ones are tried
+    // again, this time only at the points where their terrains are known to fit.
+    for( const point &sector : sectors ) {
+        if( mandatory.empty() ) {
+            break;
+        }
+        special_placement_area area( *this, sector, cache );
+        const size_t attempts = 20;
+        bool placed = false;
+
+        for( auto iter = mandatory.begin(); iter != mandatory.end(); ++iter ) {
+            const auto &special = *iter->first;
+            const auto &positions = area.fitting_positions( special );
+
+            for( size_t i = 0; i < attempts && !positions.empty() && !placed; ++i ) {
+                const tripoint p = random_entry( positions );
+                const city &nearest_city = nearest_cities.nearest( p );
+                if( !special.can_belong_to_city( p, nearest_city ) ) {
+                    continue;
+                }
+                const auto rotation = random_special_rotation( special, p );
+                if( rotation == om_direction::type::invalid ) {
+                    continue;
+                }
+                place_special( special, p, rotation, nearest_city );
+                placed = true;
+            }
+            // The terrain has changed, the area is no longer valid.
+            if( placed ) {
+                if( --iter->second == 0 ) {
+                    mandatory.erase( iter );
+                }
+                break;
+            }
+        }
+    }
 
     if( !mandatory.empty() ) {
         const std::string unplaced = enumerate_as_string( mandatory.begin(), mandatory.end(),
@@ -4386,11 +4849,13 @@ void overmap::save() const
     std::string const plrfilename = overmapbuffer::player_filename(loc.x, loc.y);
     std::string const terfilename = overmapbuffer::terrain_filename(loc.x, loc.y);
 
-    ofstream_wrapper fout_player( plrfilename );
+    const bool compressed = get_option<bool>( "SAVE_COMPRESSION" );
+
+    ofstream_wrapper fout_player( plrfilename, compressed );
     serialize_view( fout_player );
     fout_player.close();
 
-    ofstream_wrapper_exclusive fout_terrain( terfilename );
+    ofstream_wrapper_exclusive fout_terrain( terfilename, compressed );
     serialize( fout_terrain );
     fout_terrain.close();
 }
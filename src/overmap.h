@@ -288,6 +288,9 @@ public:
     bool monster_check(const std::pair<tripoint, monster> &candidate) const;
 
     void add_npc( npc &who );
+
+    /** Estimated memory used by the overmap including mongroups and NPCs, see memory_usage.h */
+    size_t estimate_memory_usage() const;
     // TODO: make private
   std::vector<radio_tower> radios;
   std::vector<npc *> npcs;
@@ -391,13 +394,19 @@ public:
   // Connection highways
   void place_hiways( const std::vector<city> &cities, int z, const std::string &base );
   void make_hiway(int x1, int y1, int x2, int y2, int z, const std::string &base);
+  /**
+   * What laying out connections of type @p base needs to know about the tiles of z-level
+   * @p z, a bitset of @ref connection_tile for each tile, indexed by y * OMAPX + x.
+   */
+  std::vector<unsigned char> connection_grid( int z, const std::string &base ) const;
+  /** Builds a connection and updates @p grid (see @ref connection_grid) accordingly. */
+  void make_hiway( std::vector<unsigned char> &grid, const tripoint &source, const tripoint &dest,
+                   const std::string &base );
   // Polishing
   bool check_ot_type(const std::string &otype, int x, int y, int z) const;
-  bool check_ot_type_road(const std::string &otype, int x, int y, int z);
   bool is_road(int x, int y, int z);
   void polish(const int z, const std::string &terrain_type="all");
   void chip_rock(int x, int y, int z);
-  oter_id good_road( const oter_type_t &type, int x, int y, int z );
   void good_river(int x, int y, int z);
   // Returns a vector of enabled overmap specials.
   std::vector<const overmap_special *> get_enabled_specials() const;
@@ -14,6 +14,7 @@
 #include "vehicle.h"
 #include "filesystem.h"
 #include "cata_utility.h"
+#include "memory_usage.h"
 
 #include <algorithm>
 #include <cassert>
@@ -60,6 +61,7 @@ overmap &overmapbuffer::get( const int x, const int y )
         return *(last_requested_overmap = it->second.get());
     }
 
+    memory_usage::tag_scope tag( memory_usage::tag::overmap );
     // That constructor loads an existing overmap or creates a new one.
     std::unique_ptr<overmap> new_om( new overmap( x, y ) );
     overmap &result = *new_om;
@@ -119,6 +121,20 @@ void overmapbuffer::clear()
     last_requested_overmap = NULL;
 }
 
+size_t overmapbuffer::loaded_count() const
+{
+    return overmaps.size();
+}
+
+size_t overmapbuffer::estimate_memory_usage() const
+{
+    size_t result = memory_usage::node_size( overmaps );
+    for( const auto &om : overmaps ) {
+        result += om.second->estimate_memory_usage();
+    }
+    return result;
+}
+
 const regional_settings& overmapbuffer::get_settings(int x, int y, int z)
 {
     (void)z;
@@ -320,25 +336,21 @@ void overmapbuffer::move_hordes()
     }
 }
 
-std::vector<mongroup*> overmapbuffer::monsters_at(int x, int y, int z)
+scratch_vector<mongroup*> overmapbuffer::monsters_at(int x, int y, int z)
 {
     // (x,y) are overmap terrain coordinates, they spawn 2x2 submaps,
     // but monster groups are defined with submap coordinates.
-    std::vector<mongroup *> result, tmp;
-    tmp = groups_at( x * 2, y * 2 , z );
-    result.insert( result.end(), tmp.begin(), tmp.end() );
-    tmp = groups_at( x * 2, y * 2 + 1, z );
-    result.insert( result.end(), tmp.begin(), tmp.end() );
-    tmp = groups_at( x * 2 + 1, y * 2 + 1, z );
-    result.insert( result.end(), tmp.begin(), tmp.end() );
-    tmp = groups_at( x * 2 + 1, y * 2 , z );
-    result.insert( result.end(), tmp.begin(), tmp.end() );
+    scratch_vector<mongroup *> result;
+    for( const point &sm : { point( 0, 0 ), point( 0, 1 ), point( 1, 1 ), point( 1, 0 ) } ) {
+        const auto tmp = groups_at( x * 2 + sm.x, y * 2 + sm.y, z );
+        result.insert( result.end(), tmp.begin(), tmp.end() );
+    }
     return result;
 }
 
-std::vector<mongroup*> overmapbuffer::groups_at(int x, int y, int z)
+scratch_vector<mongroup*> overmapbuffer::groups_at(int x, int y, int z)
 {
-    std::vector<mongroup *> result;
+    scratch_vector<mongroup *> result;
     const point omp = sm_to_om_remain( x, y );
     if( !has( omp.x, omp.y ) ) {
         return result;
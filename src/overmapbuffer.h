@@ -4,6 +4,7 @@
 #include "enums.h"
 #include "int_id.h"
 #include "overmap_types.h"
+#include "scratch_arena.h"
 
 #include <set>
 #include <list>
@@ -67,6 +68,10 @@ public:
     overmap &get( const int x, const int y );
     void save();
     void clear();
+    /** Number of overmaps currently loaded. */
+    size_t loaded_count() const;
+    /** Sum of @ref overmap::estimate_memory_usage of all loaded overmaps. */
+    size_t estimate_memory_usage() const;
 
     /**
      * Uses global overmap terrain coordinates, creates the
@@ -287,12 +292,12 @@ public:
      */
     void move_hordes();
     // hordes -- this uses overmap terrain coordinates!
-    std::vector<mongroup*> monsters_at(int x, int y, int z);
+    scratch_vector<mongroup*> monsters_at(int x, int y, int z);
     /**
      * Monster groups at (x,y,z) - absolute submap coordinates.
      * Groups with no population are not included.
      */
-    std::vector<mongroup*> groups_at(int x, int y, int z);
+    scratch_vector<mongroup*> groups_at(int x, int y, int z);
 
     /**
      * Spawn monsters from the overmap onto the main map (game::m).
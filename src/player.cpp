@@ -56,6 +56,7 @@
 #include "vitamin.h"
 #include "fault.h"
 #include "recipe_dictionary.h"
+#include "memory_usage.h"
 
 #include <map>
 #include <iterator>
@@ -532,6 +533,26 @@ void player::reset_stats()
     Character::reset_stats();
 }
 
+size_t player::estimate_memory_usage() const
+{
+    using namespace memory_usage;
+    size_t result = sizeof( player ) + Creature::estimate_memory_usage();
+    result += weapon.estimate_memory_usage() - sizeof( item );
+    result += worn.size() * list_node_size;
+    for( const auto &it : worn ) {
+        result += it.estimate_memory_usage();
+    }
+    for( const auto stack : inv.const_slice() ) {
+        result += list_node_size * 2;
+        result += stack->size() * list_node_size;
+        for( const auto &it : *stack ) {
+            result += it.estimate_memory_usage();
+        }
+    }
+    result += node_size( _skills ) + heap_size( my_bionics );
+    return result;
+}
+
 void player::process_turn()
 {
     Character::process_turn();
@@ -7,6 +7,7 @@
 #include "cata_utility.h"
 #include "crafting.h"
 #include "skill.h"
+#include "catacharset.h"
 
 #include <algorithm>
 #include <numeric>
@@ -30,57 +31,101 @@ const recipe &recipe_dictionary::get_uncraft( const itype_id &id )
     return iter != recipe_dict.uncraft.end() ? iter->second : null_recipe;
 }
 
-// searches for left-anchored partial match in the relevant recipe requirements set
-template <class group>
-bool search_reqs( group gp, const std::string &txt )
+const recipe_search_fields &recipe_dictionary::search_fields( const recipe *r ) const
 {
-    return std::any_of( gp.begin(), gp.end(), [&]( const typename group::value_type & opts ) {
-        return std::any_of( opts.begin(),
-        opts.end(), [&]( const typename group::value_type::value_type & e ) {
-            return lcmatch( e.to_string(), txt );
-        } );
-    } );
+    static const recipe_search_fields none;
+    const auto iter = search_index.find( r );
+    return iter != search_index.end() ? iter->second : none;
 }
-// template specialization to make component searches easier
-template<>
-bool search_reqs( std::vector<std::vector<item_comp> >  gp,
-                  const std::string &txt )
+
+// Appends the folded text to a list of searchable names
+static void add_search_text( std::string &list, const std::string &text )
 {
-    return std::any_of( gp.begin(), gp.end(), [&]( const std::vector<item_comp> &opts ) {
-        return std::any_of( opts.begin(), opts.end(), [&]( const item_comp & ic ) {
-            return lcmatch( item::nname( ic.type ), txt );
-        } );
-    } );
+    if( !list.empty() ) {
+        list += '\n';
+    }
+    list += fold_case( text );
+}
+
+template<typename T>
+static std::string search_texts( const std::vector<std::vector<T>> &group )
+{
+    std::string result;
+    for( const auto &opts : group ) {
+        for( const T &e : opts ) {
+            add_search_text( result, e.to_string() );
+        }
+    }
+    return result;
+}
+
+// Components are searched by name only, without the amount
+static std::string search_texts( const std::vector<std::vector<item_comp>> &group )
+{
+    std::string result;
+    for( const auto &opts : group ) {
+        for( const item_comp &e : opts ) {
+            add_search_text( result, item::nname( e.type ) );
+        }
+    }
+    return result;
+}
+
+void recipe_dictionary::build_search_index()
+{
+    recipe_dict.search_index.clear();
+    for( auto *recipes : { &recipe_dict.recipes, &recipe_dict.uncraft } ) {
+        for( const auto &e : *recipes ) {
+            const recipe &r = e.second;
+            recipe_search_fields &fields = recipe_dict.search_index[&r];
+            fields.name = fold_case( item::nname( r.result ) );
+            add_search_text( fields.skills, r.required_skills_string() );
+            add_search_text( fields.skills, r.skill_used->name() );
+            fields.components = search_texts( r.requirements().get_components() );
+            fields.tools = search_texts( r.requirements().get_tools() );
+            fields.qualities = search_texts( r.requirements().get_qualities() );
+            for( const auto &q : item::find_type( r.result )->qualities ) {
+                add_search_text( fields.result_qualities, q.first->name );
+            }
+        }
+    }
 }
 
 std::vector<const recipe *> recipe_subset::search( const std::string &txt,
         const search_type key ) const
 {
-    std::vector<const recipe *> res;
+    return search( txt, key, std::vector<const recipe *>( recipes.begin(), recipes.end() ) );
+}
+
+std::vector<const recipe *> recipe_subset::search( const std::string &txt,
+        const search_type key, const std::vector<const recipe *> &within ) const
+{
+    const std::string query = fold_case( txt );
+    const auto contains = [&query]( const std::string &text ) {
+        return text.find( query ) != std::string::npos;
+    };
 
-    std::copy_if( recipes.begin(), recipes.end(), std::back_inserter( res ), [&]( const recipe * r ) {
+    std::vector<const recipe *> res;
+    std::copy_if( within.begin(), within.end(), std::back_inserter( res ), [&]( const recipe * r ) {
+        const recipe_search_fields &fields = recipe_dict.search_fields( r );
         switch( key ) {
             case search_type::name:
-                return lcmatch( item::nname( r->result ), txt );
+                return contains( fields.name );
 
             case search_type::skill:
-                return lcmatch( r->required_skills_string(), txt ) || lcmatch( r->skill_used->name(), txt );
+                return contains( fields.skills );
 
             case search_type::component:
-                return search_reqs( r->requirements().get_components(), txt );
+                return contains( fields.components );
 
             case search_type::tool:
-                return search_reqs( r->requirements().get_tools(), txt );
+                return contains( fields.tools );
 
             case search_type::quality:
-                return search_reqs( r->requirements().get_qualities(), txt );
+                return contains( fields.qualities );
 
-            case search_type::quality_result: {
-                const auto &quals = item::find_type( r->result )->qualities;
-                return std::any_of( quals.begin(), quals.end(), [&]( const std::pair<quality_id, int> &e ) {
-                    return lcmatch( e.first->name, txt );
-                } );
-            }
+            case search_type::quality_result:
+                return contains( fields.result_qualities );
 
             default:
                 return false;
@@ -431,6 +476,8 @@ void recipe_dictionary::finalize()
             recipe_dict.autolearn.insert( &e.second );
         }
     }
+
+    build_search_index();
 }
 
 void recipe_dictionary::reset()
@@ -438,6 +485,7 @@ void recipe_dictionary::reset()
     recipe_dict.autolearn.clear();
     recipe_dict.recipes.clear();
     recipe_dict.uncraft.clear();
+    recipe_dict.search_index.clear();
 }
 
 void recipe_dictionary::delete_if( const std::function<bool( const recipe & )> &pred )
@@ -22,6 +22,7 @@
 #include "translations.h"
 #include "mongroup.h"
 #include "scent_map.h"
+#include "item.h"
 
 #include <map>
 #include <set>
@@ -752,7 +753,7 @@ void overmap::serialize_view( std::ostream &fout ) const
         json.start_array();
         serialize_array_to_compacted_sequence( json, layer[z].visible );
         json.end_array();
-        fout << std::endl;
+        json.write_line_break();
     }
     json.end_array();
 
@@ -762,7 +763,7 @@ void overmap::serialize_view( std::ostream &fout ) const
         json.start_array();
         serialize_array_to_compacted_sequence( json, layer[z].explored );
         json.end_array();
-        fout << std::endl;
+        json.write_line_break();
     }
     json.end_array();
 
@@ -776,7 +777,7 @@ void overmap::serialize_view( std::ostream &fout ) const
             json.write(i.y);
             json.write(i.text);
             json.end_array();
-            fout << std::endl;
+            json.write_line_break();
         }
         json.end_array();
     }
@@ -822,13 +823,13 @@ void overmap::serialize( std::ostream &fout ) const
         // End the z-level
         json.end_array();
         // Insert a newline occasionally so the file isn't totally unreadable.
-        fout << std::endl;
+        json.write_line_break();
     }
     json.end_array();
 
     // temporary, to allow user to manually switch regions during play until regionmap is done.
     json.member("region_id", settings.id);
-    fout << std::endl;
+    json.write_line_break();
 
     json.member("mongroups");
     json.start_array();
@@ -836,7 +837,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.write(group.second);
     }
     json.end_array();
-    fout << std::endl;
+    json.write_line_break();
 
     json.member("cities");
     json.start_array();
@@ -849,7 +850,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.write_line_break();
 
     json.member("roads_out");
     json.start_array();
@@ -860,7 +861,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.write_line_break();
 
     json.member("radios");
     json.start_array();
@@ -874,7 +875,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.write_line_break();
 
     json.member("monster_map");
     json.start_array();
@@ -883,7 +884,7 @@ void overmap::serialize( std::ostream &fout ) const
         i.second.serialize(json);
     }
     json.end_array();
-    fout << std::endl;
+    json.write_line_break();
 
     json.member("tracked_vehicles");
     json.start_array();
@@ -896,7 +897,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.write_line_break();
 
     json.member("scent_traces");
     json.start_array();
@@ -908,7 +909,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.write_line_break();
 
     json.member("npcs");
     json.start_array();
@@ -916,10 +917,10 @@ void overmap::serialize( std::ostream &fout ) const
         json.write( *i );
     }
     json.end_array();
-    fout << std::endl;
+    json.write_line_break();
 
     json.end_object();
-    fout << std::endl;
+    json.write_line_break();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -1017,6 +1018,8 @@ void game::unserialize_master(std::istream &fin) {
                 next_faction_id = jsin.get_int();
             } else if (name == "next_npc_id") {
                 next_npc_id = jsin.get_int();
+            } else if (name == "last_item_uid") {
+                item::reserve_uid( jsin.get_long() );
             } else if (name == "active_missions") {
                 mission::unserialize_all( jsin );
             } else if (name == "factions") {
@@ -1054,6 +1057,7 @@ void game::serialize_master(std::ostream &fout) {
         json.member("next_mission_id", next_mission_id);
         json.member("next_faction_id", next_faction_id);
         json.member("next_npc_id", next_npc_id);
+        json.member("last_item_uid", item::last_uid());
 
         json.member("active_missions");
         mission::serialize_all( json );
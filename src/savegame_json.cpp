@@ -342,6 +342,7 @@ void Character::load(JsonObject &data)
 
     weapon = item( "null", 0 );
     data.read( "weapon", weapon );
+    invalidate_artifact_cache();
 
     if (data.has_object("skills")) {
         JsonObject pmap = data.get_object("skills");
@@ -1456,6 +1457,7 @@ void item::io( Archive& archive )
     archive.io( "note", note, 0 );
     archive.io( "irridation", irridation, 0 );
     archive.io( "bday", bday, 0 );
+    archive.io( "uid", uid, 0L );
     archive.io( "mission_id", mission_id, -1 );
     archive.io( "player_id", player_id, -1 );
     archive.io( "item_vars", item_vars, io::empty_default_tag() );
@@ -1487,6 +1489,13 @@ void item::io( Archive& archive )
     }
     /* Loading has finished, following code is to ensure consistency and fixes bugs in saves. */
 
+    // Items from saves before items had an uid get a new one.
+    if( uid > 0 ) {
+        reserve_uid( uid );
+    } else {
+        uid = new_uid();
+    }
+
     // Old saves used to only contain one of those values (stored under "poison"), it would be
     // loaded into a union of those members. Now they are separate members and must be set separately.
     if( poison != 0 && note == 0 && !type->snippet_category.empty() ) {
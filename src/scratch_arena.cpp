@@ -0,0 +1,118 @@
+#include "scratch_arena.h"
+
+#include "debug.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+bool scratch_arena::poison = false;
+constexpr unsigned char scratch_arena::poison_byte;
+bool scratch_arena::enabled = true;
+
+scratch_arena::scratch_arena( const size_t block_size ) : block_size( block_size )
+{
+}
+
+scratch_arena::~scratch_arena() = default;
+
+size_t scratch_arena::capacity() const
+{
+    size_t result = 0;
+    for( const auto &b : blocks ) {
+        result += b.size;
+    }
+    return result;
+}
+
+bool scratch_arena::owns( const void *const ptr ) const
+{
+    const char *const p = static_cast<const char *>( ptr );
+    return std::any_of( blocks.begin(), blocks.end(), [p]( const block & b ) {
+        return p >= b.data.get() && p < b.data.get() + b.size;
+    } );
+}
+
+void scratch_arena::next_block( const size_t bytes )
+{
+    // Leave the blocks that are too small for large allocations alone, the
+    // following smaller allocations still go there.
+    size_t next = blocks.empty() ? 0 : current + 1;
+    while( next < blocks.size() && blocks[next].size < bytes ) {
+        next++;
+    }
+    if( next >= blocks.size() ) {
+        const size_t size = std::max( block_size, bytes );
+        blocks.push_back( block{ std::unique_ptr<char[]>( new char[size] ), size } );
+        next = blocks.size() - 1;
+    }
+    current = next;
+    top = blocks[current].data.get();
+    end = top + blocks[current].size;
+}
+
+void *scratch_arena::allocate( const size_t bytes, const size_t align )
+{
+    if( !enabled ) {
+        return ::operator new( bytes );
+    }
+    const auto aligned = []( char *p, const size_t align ) {
+        const auto addr = reinterpret_cast<std::uintptr_t>( p );
+        return reinterpret_cast<char *>( ( addr + align - 1 ) & ~static_cast<std::uintptr_t>( align - 1 ) );
+    };
+    char *result = top != nullptr ? aligned( top, align ) : nullptr;
+    if( result == nullptr || result + bytes > end ) {
+        next_block( bytes + align );
+        result = aligned( top, align );
+    }
+    top = result + bytes;
+    live_count++;
+    total_count++;
+    return result;
+}
+
+void scratch_arena::deallocate( void *const ptr, const size_t bytes )
+{
+    if( !owns( ptr ) ) {
+        // Allocated while the arena was disabled.
+        ::operator delete( ptr );
+        return;
+    }
+    char *const p = static_cast<char *>( ptr );
+    if( poison ) {
+        std::memset( p, poison_byte, bytes );
+    }
+    live_count--;
+    if( live_count == 0 ) {
+        current = 0;
+        top = blocks.front().data.get();
+        end = top + blocks.front().size;
+    } else if( p + bytes == top ) {
+        top = p;
+    }
+}
+
+void scratch_arena::reset()
+{
+    if( live_count != 0 ) {
+        debugmsg( "%d allocations of scratch memory are still in use", static_cast<int>( live_count ) );
+        live_count = 0;
+    }
+    if( blocks.size() > 1 ) {
+        const size_t size = capacity();
+        blocks.clear();
+        blocks.push_back( block{ std::unique_ptr<char[]>( new char[size] ), size } );
+    } else if( poison && !blocks.empty() ) {
+        std::memset( blocks.front().data.get(), poison_byte, blocks.front().size );
+    }
+    current = 0;
+    top = blocks.empty() ? nullptr : blocks.front().data.get();
+    end = blocks.empty() ? nullptr : top + blocks.front().size;
+}
+
+scratch_arena &turn_arena()
+{
+    static thread_local scratch_arena arena;
+    return arena;
+}
@@ -0,0 +1,122 @@
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Memory for short-lived containers. Allocating only bumps a pointer. Freed memory is
+ * reused right away if it was the latest allocation, and all of it once nothing is
+ * allocated anymore. Otherwise it stays used until @ref reset.
+ */
+class scratch_arena
+{
+    public:
+        scratch_arena( size_t block_size = 64 * 1024 );
+        ~scratch_arena();
+
+        scratch_arena( const scratch_arena & ) = delete;
+        scratch_arena &operator=( const scratch_arena & ) = delete;
+
+        void *allocate( size_t bytes, size_t align );
+        void deallocate( void *ptr, size_t bytes );
+
+        /**
+         * Releases everything at once. If more than one block was needed since the last
+         * reset, they are replaced by a single block that is large enough.
+         */
+        void reset();
+
+        /** Number of allocations that were not freed yet. */
+        size_t live() const {
+            return live_count;
+        }
+        /** Number of allocations that were served from the arena since it was created. */
+        size_t allocations() const {
+            return total_count;
+        }
+        /** Bytes in all blocks. */
+        size_t capacity() const;
+
+        /**
+         * Debug mode: freed memory is overwritten with @ref poison_byte, so using it
+         * afterwards shows up as garbage instead of working by accident.
+         */
+        static bool poison;
+        static constexpr unsigned char poison_byte = 0xdb;
+        /** When false, allocations go to the heap. Useful for memory checkers. */
+        static bool enabled;
+
+    private:
+        struct block {
+            std::unique_ptr<char[]> data;
+            size_t size;
+        };
+
+        bool owns( const void *ptr ) const;
+        /** Moves to the next block that can hold bytes, adding a new one if needed. */
+        void next_block( size_t bytes );
+
+        size_t block_size;
+        std::vector<block> blocks;
+        /** The block allocations are currently taken from. */
+        size_t current = 0;
+        char *top = nullptr;
+        char *end = nullptr;
+        size_t live_count = 0;
+        size_t total_count = 0;
+};
+
+/**
+ * The arena of the calling thread. The game resets the one of the main thread at the
+ * start of every turn, so containers using it must not be kept beyond that: only use
+ * them as local variables and return values, never as members.
+ */
+scratch_arena &turn_arena();
+
+/** Allocator for standard containers that takes its memory from a @ref scratch_arena. */
+template<typename T>
+class scratch_allocator
+{
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind {
+            using other = scratch_allocator<U>;
+        };
+
+        scratch_allocator() : arena( &turn_arena() ) { }
+        explicit scratch_allocator( scratch_arena &a ) : arena( &a ) { }
+        template<typename U>
+        scratch_allocator( const scratch_allocator<U> &other ) : arena( other.arena ) { }
+
+        T *allocate( const size_t n ) {
+            return static_cast<T *>( arena->allocate( n * sizeof( T ), alignof( T ) ) );
+        }
+        void deallocate( T *const ptr, const size_t n ) {
+            arena->deallocate( ptr, n * sizeof( T ) );
+        }
+
+        template<typename U>
+        bool operator==( const scratch_allocator<U> &other ) const {
+            return arena == other.arena;
+        }
+        template<typename U>
+        bool operator!=( const scratch_allocator<U> &other ) const {
+            return arena != other.arena;
+        }
+
+    private:
+        template<typename U>
+        friend class scratch_allocator;
+
+        scratch_arena *arena;
+};
+
+/** A vector for temporary data, see @ref turn_arena. */
+template<typename T>
+using scratch_vector = std::vector<T, scratch_allocator<T>>;
+
+#endif
@@ -1617,7 +1617,8 @@ WINDOW *curses_init(void)
             jOut.member("overmap_fontsize", overmap_fontsize);
             jOut.member("overmap_typeface", overmap_typeface);
             jOut.end_object();
-            OutStream << "\n";
+            jOut.write_line_break();
+            jOut.flush();
             OutStream.close();
         } else {
             dbg(D_ERROR) << "Can't load fontdata files.\n" << "Check permissions for:\n" <<
@@ -1794,7 +1795,7 @@ extern WINDOW *mainwin;
 
 // This is how we're actually going to handle input events, SDL getch
 // is simply a wrapper around this.
-input_event input_manager::get_input_event(WINDOW *win) {
+input_event input_manager::read_input_event(WINDOW *win) {
     previously_pressed_key = 0;
     // standards note: getch is sometimes required to call refresh
     // see, e.g., http://linux.die.net/man/3/getch
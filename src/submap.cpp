@@ -2,6 +2,7 @@
 #include "mapdata.h"
 #include "trap.h"
 #include "vehicle.h"
+#include "memory_usage.h"
 
 #include <memory>
 
@@ -31,6 +32,32 @@ void submap::delete_vehicles()
     vehicles.clear();
 }
 
+size_t submap::estimate_memory_usage() const
+{
+    using namespace memory_usage;
+    size_t result = sizeof( submap );
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            result += itm[x][y].size() * list_node_size;
+            for( const auto &it : itm[x][y] ) {
+                result += it.estimate_memory_usage();
+            }
+            const field &fd = fld[x][y];
+            result += fd.fieldCount() * ( tree_node_size + sizeof( std::pair<const field_id, field_entry> ) );
+            result += heap_size( cosmetics[x][y] );
+        }
+    }
+    result += heap_size( spawns );
+    for( const auto &sp : spawns ) {
+        result += heap_size( sp.name );
+    }
+    result += heap_size( vehicles );
+    for( const vehicle *veh : vehicles ) {
+        result += veh->estimate_memory_usage();
+    }
+    return result;
+}
+
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
 
 bool submap::has_graffiti( int x, int y ) const
@@ -183,6 +183,9 @@ struct submap {
     ~submap();
     // delete vehicles and clear the vehicles vector
     void delete_vehicles();
+
+    /** Estimated memory used by this submap including items and vehicles, see memory_usage.h */
+    size_t estimate_memory_usage() const;
 };
 
 /**
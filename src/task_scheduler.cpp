@@ -0,0 +1,265 @@
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <thread>
+#if ((defined _WIN32 || defined WINDOWS) && !defined _MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+namespace tasks
+{
+
+namespace
+{
+
+struct task {
+    std::function<void()> run;
+    task_group *group;
+    size_t seq;
+};
+
+struct task_queue {
+    std::mutex mutex;
+    std::deque<task> tasks;
+};
+
+constexpr size_t no_queue = std::numeric_limits<size_t>::max();
+
+/** Index of the queue owned by this thread, threads that are not workers have none. */
+thread_local size_t own_queue = no_queue;
+
+} // namespace
+
+class scheduler
+{
+    public:
+        static scheduler &instance() {
+            static scheduler s;
+            return s;
+        }
+
+        ~scheduler() {
+            stop();
+        }
+
+        unsigned workers() const {
+            return threads.size();
+        }
+
+        void set_workers( const unsigned count ) {
+            stop();
+            // The last queue takes the tasks of threads that are not workers.
+            queues.clear();
+            for( unsigned i = 0; i <= count; i++ ) {
+                queues.emplace_back( new task_queue() );
+            }
+            stopping = false;
+            for( unsigned i = 0; i < count; i++ ) {
+                threads.emplace_back( &scheduler::work, this, i );
+            }
+        }
+
+        void push( task &&t ) {
+            const size_t index = own_queue != no_queue ? own_queue : queues.size() - 1;
+            {
+                std::lock_guard<std::mutex> lock( queues[index]->mutex );
+                queues[index]->tasks.push_back( std::move( t ) );
+            }
+            queued++;
+            // Taking the lock makes sure a worker that just found nothing to do is already
+            // waiting and gets the notification.
+            {
+                std::lock_guard<std::mutex> lock( sleep_mutex );
+            }
+            wake.notify_one();
+        }
+
+        /** Runs one queued task, returns false if there was none. */
+        bool run_one() {
+            task t;
+            if( !pop( t ) ) {
+                return false;
+            }
+            execute( t );
+            return true;
+        }
+
+        static void execute( task &t ) {
+            std::exception_ptr error;
+            try {
+                t.run();
+            } catch( ... ) {
+                error = std::current_exception();
+            }
+            t.group->finish( t.seq, error );
+        }
+
+    private:
+        scheduler() {
+            const unsigned hardware = std::max( std::thread::hardware_concurrency(), 1u );
+            set_workers( hardware - 1 );
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock( sleep_mutex );
+                stopping = true;
+            }
+            wake.notify_all();
+            for( auto &t : threads ) {
+                t.join();
+            }
+            threads.clear();
+        }
+
+        /**
+         * Takes the newest task of the own queue (it's most likely still in the cache),
+         * otherwise the oldest task of the shared queue or of another worker.
+         */
+        bool pop( task &t ) {
+            if( own_queue != no_queue && take( *queues[own_queue], t, true ) ) {
+                return true;
+            }
+            const size_t start = own_queue != no_queue ? own_queue + 1 : queues.size() - 1;
+            for( size_t i = 0; i < queues.size(); i++ ) {
+                const size_t victim = ( start + i ) % queues.size();
+                if( victim != own_queue && take( *queues[victim], t, false ) ) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool take( task_queue &q, task &t, const bool newest ) {
+            std::lock_guard<std::mutex> lock( q.mutex );
+            if( q.tasks.empty() ) {
+                return false;
+            }
+            if( newest ) {
+                t = std::move( q.tasks.back() );
+                q.tasks.pop_back();
+            } else {
+                t = std::move( q.tasks.front() );
+                q.tasks.pop_front();
+            }
+            queued--;
+            return true;
+        }
+
+        void work( const size_t index ) {
+            own_queue = index;
+            while( true ) {
+                if( run_one() ) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock( sleep_mutex );
+                wake.wait( lock, [this]() {
+                    return stopping || queued > 0;
+                } );
+                if( stopping && queued == 0 ) {
+                    return;
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<task_queue>> queues;
+        std::vector<std::thread> threads;
+        std::atomic<size_t> queued{ 0 };
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+};
+
+void set_workers( const unsigned count )
+{
+    scheduler::instance().set_workers( count );
+}
+
+unsigned workers()
+{
+    return scheduler::instance().workers();
+}
+
+task_group::~task_group()
+{
+    try {
+        wait();
+    } catch( ... ) {
+    }
+}
+
+void task_group::run( const std::function<void()> &f )
+{
+    task t{ f, this, started++ };
+    pending++;
+    auto &s = scheduler::instance();
+    if( s.workers() == 0 ) {
+        scheduler::execute( t );
+    } else {
+        s.push( std::move( t ) );
+    }
+}
+
+void task_group::wait()
+{
+    auto &s = scheduler::instance();
+    while( pending > 0 ) {
+        if( !s.run_one() ) {
+            std::this_thread::yield();
+        }
+    }
+    if( error ) {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception( e );
+    }
+}
+
+void task_group::finish( const size_t seq, std::exception_ptr e )
+{
+    if( e ) {
+        std::lock_guard<std::mutex> lock( error_mutex );
+        if( !error || seq < error_seq ) {
+            error = e;
+            error_seq = seq;
+        }
+    }
+    // The group may be gone as soon as this reaches 0.
+    pending--;
+}
+
+std::vector<std::pair<size_t, size_t>> chunks( const size_t begin, const size_t end,
+        size_t grain )
+{
+    grain = std::max<size_t>( grain, 1 );
+    std::vector<std::pair<size_t, size_t>> result;
+    for( size_t b = begin; b < end; b += std::min( grain, end - b ) ) {
+        result.emplace_back( b, b + std::min( grain, end - b ) );
+    }
+    return result;
+}
+
+void parallel_for( const size_t begin, const size_t end, const size_t grain,
+                   const std::function<void( size_t, size_t )> &body )
+{
+    const auto parts = chunks( begin, end, grain );
+    if( parts.size() == 1 || workers() == 0 ) {
+        for( const auto &p : parts ) {
+            body( p.first, p.second );
+        }
+        return;
+    }
+    task_group group;
+    for( const auto &p : parts ) {
+        group.run( [&body, p]() {
+            body( p.first, p.second );
+        } );
+    }
+    group.wait();
+}
+
+} // namespace tasks
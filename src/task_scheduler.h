@@ -0,0 +1,110 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A small work-stealing task scheduler. Each worker thread has its own queue of tasks and
+ * takes work from the other queues when its own is empty. A thread waiting for its tasks
+ * runs queued tasks itself, so tasks may fork and join more tasks without deadlocking.
+ *
+ * Only use it for work that does not touch shared game state (or only reads it), and never
+ * call @ref debugmsg or other UI functions from a task.
+ */
+namespace tasks
+{
+
+class scheduler;
+
+/**
+ * Sets the number of worker threads. With 0 every task runs right away on the thread that
+ * creates it, which is useful for debugging. Must not be called from inside a task.
+ */
+void set_workers( unsigned count );
+/** Number of worker threads, by default one less than the number of hardware threads. */
+unsigned workers();
+
+/**
+ * Fork/join: tasks started with @ref run may run concurrently, @ref wait returns when all
+ * of them are done. If tasks throw, wait rethrows the exception of the one started first.
+ */
+class task_group
+{
+    public:
+        task_group() = default;
+        /** Waits for remaining tasks, but drops their exceptions. */
+        ~task_group();
+
+        task_group( const task_group & ) = delete;
+        task_group &operator=( const task_group & ) = delete;
+
+        void run( const std::function<void()> &task );
+        void wait();
+
+    private:
+        friend class scheduler;
+        /** Called once the task started as number seq of this group is done. */
+        void finish( size_t seq, std::exception_ptr error );
+
+        std::atomic<size_t> pending{ 0 };
+        size_t started = 0;
+        std::mutex error_mutex;
+        size_t error_seq = 0;
+        std::exception_ptr error;
+};
+
+/**
+ * The chunks [begin, end) is split into. They depend only on the range and the grain size
+ * (the maximal chunk length), not on the number of threads.
+ */
+std::vector<std::pair<size_t, size_t>> chunks( size_t begin, size_t end, size_t grain );
+
+/** Calls body( chunk_begin, chunk_end ) for each chunk of [begin, end), in parallel. */
+void parallel_for( size_t begin, size_t end, size_t grain,
+                   const std::function<void( size_t, size_t )> &body );
+
+/** Returns { f( begin ), ..., f( end - 1 ) }, computed in parallel. */
+template<typename T, typename F>
+std::vector<T> parallel_transform( size_t begin, size_t end, size_t grain, const F &f )
+{
+    // Elements of std::vector<bool> can't be written concurrently.
+    static_assert( !std::is_same<T, bool>::value, "use char instead of bool" );
+    std::vector<T> result( end > begin ? end - begin : 0 );
+    parallel_for( begin, end, grain, [&]( const size_t b, const size_t e ) {
+        for( size_t i = b; i < e; i++ ) {
+            result[i - begin] = f( i );
+        }
+    } );
+    return result;
+}
+
+/**
+ * Reduces each chunk of [begin, end) with map( chunk_begin, chunk_end ) in parallel, then
+ * folds the chunk results from left to right with combine, starting with init.
+ * Since the chunks don't depend on the number of threads, neither does the result, even
+ * if combine is not associative (like adding floating point numbers).
+ */
+template<typename T, typename Map, typename Combine>
+T parallel_reduce( size_t begin, size_t end, size_t grain, T init, const Map &map,
+                   const Combine &combine )
+{
+    const auto parts = chunks( begin, end, grain );
+    const auto results = parallel_transform<T>( 0, parts.size(), 1, [&]( const size_t i ) {
+        return map( parts[i].first, parts[i].second );
+    } );
+    for( const T &r : results ) {
+        init = combine( init, r );
+    }
+    return init;
+}
+
+} // namespace tasks
+
+#endif
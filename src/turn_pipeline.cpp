@@ -0,0 +1,45 @@
+#include "turn_pipeline.h"
+
+#include "task_scheduler.h"
+
+#include <algorithm>
+
+bool turn_pipeline::parallel = true;
+
+void turn_pipeline::add( const std::string &name, const unsigned reads, const unsigned writes,
+                         const std::function<void()> &run )
+{
+    const stage added{ name, reads, writes, run };
+    // The first wave after all earlier stages it conflicts with.
+    size_t wave = 0;
+    for( size_t i = 0; i < stages.size(); i++ ) {
+        if( stages[i].conflicts( added ) ) {
+            wave = std::max( wave, stage_wave[i] + 1 );
+        }
+    }
+    if( wave == stage_waves.size() ) {
+        stage_waves.emplace_back();
+    }
+    stage_waves[wave].push_back( stages.size() );
+    stage_wave.push_back( wave );
+    stages.push_back( added );
+}
+
+void turn_pipeline::run() const
+{
+    for( const auto &wave : stage_waves ) {
+        if( !parallel || wave.size() == 1 ) {
+            for( const size_t i : wave ) {
+                stages[i].run();
+            }
+            continue;
+        }
+
+        tasks::task_group group;
+        for( const size_t i : wave ) {
+            group.run( stages[i].run );
+        }
+        // Rethrows the error of the earliest stage, as running them in order would have.
+        group.wait();
+    }
+}
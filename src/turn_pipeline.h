@@ -0,0 +1,85 @@
+#ifndef TURN_PIPELINE_H
+#define TURN_PIPELINE_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * The kinds of game data that stages of a turn read or write. Two stages may run at the
+ * same time only if neither writes data the other one reads or writes.
+ */
+enum turn_data : unsigned {
+    /** Terrain, furniture and traps of the reality bubble. */
+    TD_TERRAIN = 1 << 0,
+    /** Floor, transparency, light and other caches of the map. */
+    TD_MAP_CACHES = 1 << 1,
+    TD_FIELDS = 1 << 2,
+    TD_ITEMS = 1 << 3,
+    TD_VEHICLES = 1 << 4,
+    /** The player, npcs and monsters. */
+    TD_CREATURES = 1 << 5,
+    TD_SCENT = 1 << 6,
+    TD_SOUNDS = 1 << 7,
+    TD_WEATHER = 1 << 8,
+    /** Overmaps and their hordes, the scent trail and notes. */
+    TD_OVERMAP = 1 << 9,
+    /** The global random number generator, every use changes its state. */
+    TD_RNG = 1 << 10,
+    /** Messages, sounds and everything else visible to the player. */
+    TD_OUTPUT = 1 << 11,
+    TD_ALL = ~0u
+};
+
+/**
+ * The steps of a turn as a graph of stages. Each stage declares which @ref turn_data it
+ * reads and writes. Stages that conflict always run in the order they were added, others
+ * may run concurrently. Because of this the results are the same as running every stage
+ * in order, no matter how many threads are used.
+ */
+class turn_pipeline
+{
+    public:
+        void add( const std::string &name, unsigned reads, unsigned writes,
+                  const std::function<void()> &run );
+
+        /** Runs all stages, waits until all of them are done. */
+        void run() const;
+
+        /**
+         * Indexes of the stages, grouped into waves. Each wave runs after the previous one
+         * is done, the stages in a wave don't conflict and run concurrently.
+         */
+        const std::vector<std::vector<size_t>> &waves() const {
+            return stage_waves;
+        }
+        const std::string &name( size_t stage ) const {
+            return stages[stage].name;
+        }
+
+        /**
+         * When false, all stages run one after another on the calling thread. Otherwise the
+         * stages of a wave run as tasks, see @ref tasks::task_group.
+         */
+        static bool parallel;
+
+    private:
+        struct stage {
+            std::string name;
+            unsigned reads;
+            unsigned writes;
+            std::function<void()> run;
+
+            bool conflicts( const stage &other ) const {
+                return ( writes & ( other.reads | other.writes ) ) != 0 ||
+                       ( other.writes & reads ) != 0;
+            }
+        };
+
+        std::vector<stage> stages;
+        /** Wave of each stage. */
+        std::vector<size_t> stage_wave;
+        std::vector<std::vector<size_t>> stage_waves;
+};
+
+#endif
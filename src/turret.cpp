@@ -7,6 +7,7 @@
 #include "veh_type.h"
 #include "vehicle_selector.h"
 #include "npc.h"
+#include "fake_shooter.h"
 #include "projectile.h"
 #include "messages.h"
 #include "translations.h"
@@ -395,7 +396,7 @@ bool vehicle::turrets_aim()
     return !trajectory.empty();
 }
 
-int vehicle::automatic_fire_turret( vehicle_part &pt )
+int vehicle::automatic_fire_turret( vehicle_part &pt, const std::vector<Creature *> &candidates )
 {
     auto gun = turret_query( pt );
     if( gun.query() != turret_data::status::ready ) {
@@ -404,18 +405,18 @@ int vehicle::automatic_fire_turret( vehicle_part &pt )
 
     tripoint pos = global_part_pos3( pt );
 
-    npc tmp;
-    tmp.set_fake( true );
-    tmp.name = string_format( pgettext( "vehicle turret", "The %s" ), pt.name().c_str() );
-    tmp.set_skill_level( gun.base()->gun_skill(), 8 );
-    tmp.set_skill_level( skill_id( "gun" ), 4 );
-    tmp.recoil = 0; // turrets are subject only to recoil_vehicle()
-    tmp.setpos( pos );
-    tmp.str_cur = 16;
-    tmp.dex_cur = 8;
-    tmp.per_cur = 12;
+    shooter_profile profile;
+    profile.name = string_format( pgettext( "vehicle turret", "The %s" ), pt.name().c_str() );
+    profile.skills = { { gun.base()->gun_skill(), 8 }, { skill_id( "gun" ), 4 } };
+    profile.recoil = 0; // turrets are subject only to recoil_vehicle()
+    profile.pos = pos;
+    profile.str = 16;
+    profile.dex = 8;
+    profile.per = 12;
     // Assume vehicle turrets are friendly to the player.
-    tmp.attitude = NPCATT_FOLLOW;
+    profile.friendly = true;
+    fake_shooter shooter( profile );
+    npc &tmp = *shooter;
 
     int area = aoe_size( gun.ammo_effects() );
     if( area > 0 ) {
@@ -431,7 +432,7 @@ int vehicle::automatic_fire_turret( vehicle_part &pt )
 
         // @todo calculate chance to hit and cap range based upon this
         int range = std::min( gun.range(), 12 );
-        Creature *auto_target = tmp.auto_find_hostile_target( range, boo_hoo, area );
+        Creature *auto_target = tmp.auto_find_hostile_target( range, boo_hoo, area, candidates );
         if( auto_target == nullptr ) {
             if( u_see && boo_hoo ) {
                 add_msg( m_warning, ngettext( "%s points in your direction and emits an IFF warning beep.",
@@ -31,6 +31,7 @@
 #include "map_iterator.h"
 #include "vehicle_selector.h"
 #include "cata_utility.h"
+#include "memory_usage.h"
 
 #include <sstream>
 #include <stdlib.h>
@@ -1056,6 +1057,7 @@ bool vehicle::fold_up() {
         std::ostringstream veh_data;
         JsonOut json(veh_data);
         json.write(parts);
+        json.flush();
         bicycle.set_var( "folding_bicycle_parts", veh_data.str() );
     } catch( const JsonError &e ) {
         debugmsg("Error storing vehicle: %s", e.c_str());
@@ -4670,9 +4672,16 @@ void vehicle::gain_moves()
     }
 
     // turrets which are enabled will try to reload and then automatically fire
-    for( auto e : turrets() ) {
-        if( e->enabled ) {
-            automatic_fire_turret( *e );
+    const auto all_turrets = turrets();
+    if( std::any_of( all_turrets.begin(), all_turrets.end(), []( const vehicle_part * e ) {
+        return e->enabled;
+    } ) ) {
+        // All turrets choose among the same creatures, so they are only collected once.
+        const std::vector<Creature *> candidates = Creature::hostile_target_candidates();
+        for( auto e : all_turrets ) {
+            if( e->enabled ) {
+                automatic_fire_turret( *e, candidates );
+            }
         }
     }
 
@@ -4681,6 +4690,30 @@ void vehicle::gain_moves()
     }
 }
 
+size_t vehicle::estimate_memory_usage() const
+{
+    using namespace memory_usage;
+    size_t result = sizeof( vehicle ) + heap_size( name ) + heap_size( parts );
+    for( const auto &pt : parts ) {
+        result += pt.items.size() * list_node_size;
+        for( const auto &it : pt.items ) {
+            result += it.estimate_memory_usage();
+        }
+        result += pt.base.estimate_memory_usage() - sizeof( item );
+    }
+    result += node_size( relative_parts );
+    for( const auto &rp : relative_parts ) {
+        result += heap_size( rp.second );
+    }
+    result += node_size( labels ) + node_size( tags );
+    for( const std::vector<int> *cache : { &alternators, &engines, &reactors, &solar_panels,
+                                           &funnels, &loose_parts, &wheelcache, &steering,
+                                           &speciality, &floating } ) {
+        result += heap_size( *cache );
+    }
+    return result;
+}
+
 /**
  * Refreshes all caches and refinds all parts. Used after the vehicle has had a part added or removed.
  * Makes indices of different part types so they're easy to find. Also calculates power drain.
@@ -20,6 +20,7 @@
 #include <string>
 #include <iosfwd>
 
+class Creature;
 class map;
 class player;
 class vehicle;
@@ -1028,6 +1029,9 @@ public:
 
     void gain_moves();
 
+    /** Estimated memory used by the vehicle including cargo, see memory_usage.h */
+    size_t estimate_memory_usage() const;
+
     // reduces velocity to 0
     void stop ();
 
@@ -1270,9 +1274,10 @@ private:
 
     /*
      * Fire turret at automatically acquired targets
+     * @param candidates Creatures the turret may target, see Creature::hostile_target_candidates
      * @return number of shots actually fired (which may be zero)
      */
-    int automatic_fire_turret( vehicle_part &pt );
+    int automatic_fire_turret( vehicle_part &pt, const std::vector<Creature *> &candidates );
 
     mutable bool mass_dirty                     = true;
     mutable bool mass_center_precalc_dirty      = true;
@@ -0,0 +1 @@
+#define VERSION "586040f-dirty"
@@ -533,6 +533,8 @@ std::list<item> visitable<Character>::remove_items_with( const
         return res; // nothing to do
     }
 
+    ch->invalidate_artifact_cache();
+
     // first try and remove items from the inventory
     res = ch->inv.remove_items_with( filter, count );
     count -= res.size();
@@ -518,7 +518,8 @@ WINDOW *curses_init(void)
             jOut.member("overmap_fontsize", overmap_fontsize);
             jOut.member("overmap_typeface", overmap_typeface);
             jOut.end_object();
-            OutStream << "\n";
+            jOut.write_line_break();
+            jOut.flush();
             OutStream.close();
         } else {
             DebugLog( D_ERROR, DC_ALL ) << "Can't load fontdata files.\n"
@@ -0,0 +1,107 @@
+#include "catch/catch.hpp"
+
+#include "artifact.h"
+#include "game.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "map.h"
+#include "player.h"
+
+static std::string make_artifact_tool( art_effect_passive wielded, art_effect_passive carried )
+{
+    it_artifact_tool def;
+    def.create_name( "test tool" );
+    def.volume = units::from_milliliter( 250 );
+    def.artifact->effects_wielded.push_back( wielded );
+    def.artifact->effects_carried.push_back( carried );
+    item_controller->add_item_type( static_cast<itype &>( def ) );
+    return def.get_id();
+}
+
+static std::string make_artifact_armor( art_effect_passive worn )
+{
+    it_artifact_armor def;
+    def.create_name( "test armor" );
+    def.volume = units::from_milliliter( 250 );
+    def.artifact->effects_worn.push_back( worn );
+    item_controller->add_item_type( static_cast<itype &>( def ) );
+    return def.get_id();
+}
+
+TEST_CASE( "artifact_effect_cache", "[artifact] [item]" ) {
+    player &p = g->u;
+    p.worn.clear();
+    p.inv.clear();
+    p.remove_weapon();
+    p.wear_item( item( "backpack" ), false ); // so we don't drop anything
+
+    const item tool( make_artifact_tool( AEP_SPEED_UP, AEP_GLOW ) );
+    const item armor( make_artifact_armor( AEP_STEALTH ) );
+
+    REQUIRE_FALSE( p.has_artifact_with( AEP_SPEED_UP ) );
+    REQUIRE_FALSE( p.has_artifact_with( AEP_GLOW ) );
+    REQUIRE_FALSE( p.has_artifact_with( AEP_STEALTH ) );
+
+    SECTION( "carried and wielded effects" ) {
+        item &obj = p.i_add( tool );
+        CHECK( p.has_artifact_with( AEP_GLOW ) );
+        CHECK_FALSE( p.has_artifact_with( AEP_SPEED_UP ) );
+
+        REQUIRE( p.wield( obj ) );
+        CHECK( p.has_artifact_with( AEP_GLOW ) );
+        CHECK( p.has_artifact_with( AEP_SPEED_UP ) );
+
+        WHEN( "the artifact is put away" ) {
+            p.i_add( p.remove_weapon() );
+            THEN( "only the carried effect remains" ) {
+                CHECK( p.has_artifact_with( AEP_GLOW ) );
+                CHECK_FALSE( p.has_artifact_with( AEP_SPEED_UP ) );
+            }
+        }
+
+        WHEN( "the artifact is dropped" ) {
+            p.i_rem( -1 );
+            THEN( "no effects remain" ) {
+                CHECK_FALSE( p.has_artifact_with( AEP_GLOW ) );
+                CHECK_FALSE( p.has_artifact_with( AEP_SPEED_UP ) );
+            }
+        }
+    }
+
+    SECTION( "worn effects" ) {
+        REQUIRE( p.wear_item( armor, false ) );
+        CHECK( p.has_artifact_with( AEP_STEALTH ) );
+
+        WHEN( "the artifact is taken off" ) {
+            REQUIRE( p.takeoff( p.worn.back() ) );
+            THEN( "the worn effect no longer applies" ) {
+                CHECK_FALSE( p.has_artifact_with( AEP_STEALTH ) );
+                REQUIRE( p.has_amount( armor.typeId(), 1 ) );
+            }
+        }
+    }
+
+    SECTION( "artifact nested within a container" ) {
+        item container( "bag_plastic" );
+        container.put_in( tool );
+        const item &bag = p.i_add( container );
+        CHECK( p.has_artifact_with( AEP_GLOW ) );
+        CHECK_FALSE( p.has_artifact_with( AEP_SPEED_UP ) );
+
+        WHEN( "the container is dropped" ) {
+            p.i_rem( &bag );
+            THEN( "the carried effect is gone" ) {
+                CHECK_FALSE( p.has_artifact_with( AEP_GLOW ) );
+            }
+        }
+
+        WHEN( "the artifact is taken out of the container" ) {
+            p.remove_items_with( [&tool]( const item &e ) {
+                return e.typeId() == tool.typeId();
+            } );
+            THEN( "the carried effect is gone" ) {
+                CHECK_FALSE( p.has_artifact_with( AEP_GLOW ) );
+            }
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#include "catch/catch.hpp"
+
+#include "cata_utility.h"
+#include "compression.h"
+#include "coordinate_conversions.h"
+#include "enums.h"
+#include "item.h"
+#include "json.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "submap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+
+static std::string round_trip( const std::string &data )
+{
+    const std::string block = compression::compress_block( data.data(), data.size() );
+    std::string result;
+    REQUIRE( compression::decompress_block( block.data(), block.size(), data.size(), result ) );
+    return result;
+}
+
+TEST_CASE( "compression_round_trip", "[compression]" ) {
+    CHECK( round_trip( "" ).empty() );
+    CHECK( round_trip( "a" ) == "a" );
+    CHECK( round_trip( "short text" ) == "short text" );
+
+    // Long runs need the extended length encoding and overlapping copies.
+    const std::string run( 100000, 'x' );
+    CHECK( round_trip( run ) == run );
+    CHECK( compression::compress_block( run.data(), run.size() ).size() < 1000 );
+
+    std::minstd_rand generator( 42 );
+    std::string random;
+    for( int i = 0; i < 70000; i++ ) {
+        random.push_back( static_cast<char>( generator() & 0xff ) );
+    }
+    CHECK( round_trip( random ) == random );
+
+    std::string json;
+    for( int i = 0; i < 2000; i++ ) {
+        json += "{\"typeid\":\"rock\",\"charges\":" + std::to_string( i % 7 ) + "},";
+    }
+    CHECK( round_trip( json ) == json );
+    CHECK( compression::pack( json ).size() < json.size() / 10 );
+    CHECK( compression::unpack( compression::pack( json ) ) == json );
+}
+
+TEST_CASE( "compression_rejects_corrupt_data", "[compression]" ) {
+    const std::string text( 1000, 'a' );
+    const std::string block = compression::compress_block( text.data(), text.size() );
+    std::string result;
+    CHECK_FALSE( compression::decompress_block( block.data(), block.size(), text.size() + 1, result ) );
+    CHECK_FALSE( compression::decompress_block( block.data(), block.size() - 1, text.size(), result ) );
+
+    CHECK_FALSE( compression::is_packed( "[{\"version\":26}]" ) );
+    CHECK_THROWS( compression::unpack( "# version 26\n{}" ) );
+    std::string packed = compression::pack( text );
+    packed.resize( packed.size() - 3 );
+    CHECK_THROWS( compression::unpack( packed ) );
+}
+
+TEST_CASE( "compressed_files_are_read_transparently", "[compression]" ) {
+    const std::string path = "compression_test.tmp";
+    const std::string content = "{\"some\":[\"content\",\"content\",\"content\",\"content\"]}";
+    for( const bool compressed : { false, true } ) {
+        REQUIRE( write_to_file( path, [&]( std::ostream & fout ) {
+            fout << content;
+        }, nullptr, compressed ) );
+
+        std::string read;
+        CHECK( read_from_file( path, [&]( std::istream & fin ) {
+            std::ostringstream buffer;
+            buffer << fin.rdbuf();
+            read = buffer.str();
+        } ) );
+        CHECK( read == content );
+    }
+    std::remove( path.c_str() );
+}
+
+static std::string quad_text( const mapbuffer &buffer, const tripoint &om_addr )
+{
+    std::ostringstream out;
+    buffer.write_quad( out, om_addr );
+    return out.str();
+}
+
+TEST_CASE( "quads_store_uniform_and_identical_submaps_once", "[compression]" ) {
+    const tripoint om_addr( 100, 100, -2 );
+    const tripoint sm_addr = omt_to_sm_copy( om_addr );
+    mapbuffer buffer;
+    // Copies of one item, separately created items would differ in their uid
+    const item rock( "rock" );
+    for( int i = 0; i < 4; i++ ) {
+        std::unique_ptr<submap> sm( new submap() );
+        for( int x = 0; x < SEEX; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                sm->ter[x][y] = t_rock;
+            }
+        }
+        if( i >= 2 ) {
+            sm->ter[1][2] = t_rock_floor;
+            sm->itm[1][2].push_back( rock );
+        }
+        REQUIRE( buffer.add_submap( sm_addr + tripoint( i / 2, i % 2, 0 ), sm ) );
+    }
+
+    const std::string text = quad_text( buffer, om_addr );
+    CHECK( text.find( "\"uniform_terrain\"" ) != std::string::npos );
+    CHECK( text.find( "\"terrain\"" ) == text.rfind( "\"terrain\"" ) );
+    CHECK( text.find( "\"same_as\"" ) != text.rfind( "\"same_as\"" ) );
+
+    mapbuffer loaded;
+    std::istringstream fin( text );
+    JsonIn jsin( fin );
+    loaded.deserialize( jsin );
+    CHECK( quad_text( loaded, om_addr ) == text );
+    submap *copy = loaded.lookup_submap( sm_addr + tripoint( 1, 1, 0 ) );
+    REQUIRE( copy != nullptr );
+    CHECK( copy->ter[0][0] == t_rock );
+    CHECK( copy->ter[1][2] == t_rock_floor );
+    REQUIRE( copy->itm[1][2].size() == 1 );
+    CHECK( copy->itm[1][2].front().typeId() == "rock" );
+}
+
+TEST_CASE( "generated_world_quads_round_trip_compressed", "[compression]" ) {
+    std::set<tripoint> quads;
+    for( const auto &sm : MAPBUFFER ) {
+        quads.insert( sm_to_omt_copy( sm.first ) );
+    }
+    REQUIRE_FALSE( quads.empty() );
+
+    std::string all;
+    for( const tripoint &om_addr : quads ) {
+        const std::string text = quad_text( MAPBUFFER, om_addr );
+        const std::string packed = compression::pack( text );
+        CHECK( packed.size() < text.size() / 3 );
+        CHECK( compression::unpack( packed ) == text );
+
+        mapbuffer loaded;
+        std::istringstream fin( text );
+        JsonIn jsin( fin );
+        loaded.deserialize( jsin );
+        CHECK( quad_text( loaded, om_addr ) == text );
+        all += text;
+    }
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    const std::string packed = compression::pack( all );
+    const auto packed_time = clock::now();
+    CHECK( compression::unpack( packed ) == all );
+    const auto end = clock::now();
+    const double mb = all.size() / ( 1024.0 * 1024.0 );
+    const double pack_seconds = std::chrono::duration<double>( packed_time - start ).count();
+    const double unpack_seconds = std::chrono::duration<double>( end - packed_time ).count();
+    INFO( mb << " MiB packed to " << packed.size() << " bytes, " << mb / pack_seconds <<
+          " MiB/s compressing, " << mb / unpack_seconds << " MiB/s decompressing" );
+    CHECK( packed.size() < all.size() / 4 );
+    // Very loose bounds, saving and loading must not become noticeably slower.
+    CHECK( mb / pack_seconds > 5 );
+    CHECK( mb / unpack_seconds > 5 );
+}
@@ -6,6 +6,9 @@
 #include "npc.h"
 #include "player.h"
 #include "recipe_dictionary.h"
+#include "requirements.h"
+#include "cata_utility.h"
+#include "skill.h"
 
 TEST_CASE( "recipe_subset" ) {
     recipe_subset subset;
@@ -101,6 +104,83 @@ TEST_CASE( "recipe_subset" ) {
     }
 }
 
+template<typename T>
+static bool any_text( const std::vector<std::vector<T>> &group, const std::string &txt )
+{
+    for( const auto &opts : group ) {
+        for( const T &e : opts ) {
+            if( lcmatch( e.to_string(), txt ) ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// The search as it was before the texts were indexed
+static bool search_reference( const recipe &r, const std::string &txt,
+                              const recipe_subset::search_type key )
+{
+    const auto any_name = [&txt]( const std::vector<std::vector<item_comp>> &group ) {
+        for( const auto &opts : group ) {
+            for( const item_comp &e : opts ) {
+                if( lcmatch( item::nname( e.type ), txt ) ) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+    switch( key ) {
+        case recipe_subset::search_type::name:
+            return lcmatch( item::nname( r.result ), txt );
+        case recipe_subset::search_type::skill:
+            return lcmatch( r.required_skills_string(), txt ) || lcmatch( r.skill_used->name(), txt );
+        case recipe_subset::search_type::component:
+            return any_name( r.requirements().get_components() );
+        case recipe_subset::search_type::tool:
+            return any_text( r.requirements().get_tools(), txt );
+        case recipe_subset::search_type::quality:
+            return any_text( r.requirements().get_qualities(), txt );
+        case recipe_subset::search_type::quality_result:
+            for( const auto &q : item::find_type( r.result )->qualities ) {
+                if( lcmatch( q.first->name, txt ) ) {
+                    return true;
+                }
+            }
+            return false;
+    }
+    return false;
+}
+
+TEST_CASE( "recipe_search_uses_the_index", "[crafting]" ) {
+    recipe_subset subset;
+    for( const auto &e : recipe_dict ) {
+        subset.include( &e.second );
+    }
+    using st = recipe_subset::search_type;
+    const std::vector<std::pair<st, std::string>> queries = {
+        { st::name, "A" }, { st::name, "Steel" }, { st::skill, "cook" }, { st::skill, "3" },
+        { st::component, "water" }, { st::tool, "hammer" }, { st::tool, "charges" },
+        { st::quality, "cutting" }, { st::quality_result, "boil" }, { st::name, "no such thing" }
+    };
+    for( const auto &q : queries ) {
+        std::vector<const recipe *> expected;
+        for( const recipe *r : subset ) {
+            if( search_reference( *r, q.second, q.first ) ) {
+                expected.push_back( r );
+            }
+        }
+        CAPTURE( q.second );
+        CHECK( subset.search( q.second, q.first ) == expected );
+    }
+
+    // Narrowing the results of a shorter query gives the same results.
+    const auto st_results = subset.search( "st" );
+    CHECK( subset.search( "STE", st::name, st_results ) == subset.search( "ste" ) );
+    CHECK( subset.search( "ste" ).size() < st_results.size() );
+}
+
 // This crashes subsequent testcases for some reason.
 TEST_CASE( "available_recipes", "[.]" ) {
     const recipe *r = &recipe_dict[ "brew_mead" ];
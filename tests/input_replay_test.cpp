@@ -0,0 +1,59 @@
+#include "catch/catch.hpp"
+
+#include "input.h"
+#include "input_replay.h"
+#include "rng.h"
+
+#include <cstdio>
+
+TEST_CASE( "input_replay_round_trip", "[input]" ) {
+    const std::string path = "test_input_session";
+
+    input_event key( 'k', CATA_INPUT_KEYBOARD );
+    key.text = "k";
+    input_event click( MOUSE_BUTTON_LEFT, CATA_INPUT_MOUSE );
+    click.mouse_x = 12;
+    click.mouse_y = 7;
+    input_event text( 0x263a, CATA_INPUT_KEYBOARD );
+    text.text = "\xe2\x98\xba";
+
+    input_replay::start_recording( path, 1234 );
+    REQUIRE( input_replay::is_recording() );
+    input_replay::on_turn_start();
+    const long recorded_roll = rng( 0, 1000000 );
+    input_replay::record( key );
+    input_replay::record( click );
+    input_replay::record( text );
+    input_replay::on_turn_start();
+    input_replay::stop();
+
+    // Consume some random numbers, the replay must reseed the generator.
+    rng( 0, 100 );
+    rng( 0, 100 );
+
+    REQUIRE( input_replay::start_replay( path ) );
+    REQUIRE( input_replay::is_replaying() );
+    CHECK( input_replay::replay_seed() == 1234 );
+
+    input_replay::on_turn_start();
+    CHECK( rng( 0, 1000000 ) == recorded_roll );
+
+    const input_event first = input_replay::next_event();
+    CHECK( first == key );
+    CHECK( first.text == key.text );
+    const input_event second = input_replay::next_event();
+    CHECK( second == click );
+    CHECK( second.mouse_x == 12 );
+    CHECK( second.mouse_y == 7 );
+    const input_event third = input_replay::next_event();
+    CHECK( third == text );
+    CHECK( third.text == text.text );
+
+    input_replay::stop();
+    CHECK_FALSE( input_replay::is_replaying() );
+    std::remove( path.c_str() );
+}
+
+TEST_CASE( "state_checksum_is_stable", "[input]" ) {
+    CHECK( input_replay::state_checksum() == input_replay::state_checksum() );
+}
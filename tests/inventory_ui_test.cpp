@@ -0,0 +1,89 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "inventory_ui.h"
+#include "item.h"
+#include "map.h"
+#include "map_selector.h"
+#include "player.h"
+
+#include <string>
+#include <vector>
+
+class test_column : public inventory_column
+{
+    public:
+        using inventory_column::entries;
+        using inventory_column::page_of;
+};
+
+TEST_CASE( "inventory_column_orders_entries_by_category_and_name", "[inventory]" ) {
+    const tripoint pos = g->u.pos() + tripoint( 1, 0, 0 );
+    g->m.i_clear( pos );
+
+    const item_category cat_late( "TEST_LATE", "LATE", 10 );
+    const item_category cat_first( "TEST_FIRST", "FIRST", 5 );
+    const item_category cat_second( "TEST_SECOND", "SECOND", 5 );
+    const std::vector<const item_category *> categories = {{ &cat_late, &cat_first, &cat_second }};
+
+    const std::vector<std::string> ids = {{ "rock", "stick", "2x4", "rag", "pipe", "scrap" }};
+    for( int i = 0; i < 4; i++ ) {
+        for( const auto &id : ids ) {
+            g->m.add_item( pos, item( id ) );
+        }
+    }
+
+    test_column column;
+    const size_t page_size = 5;
+    column.set_height( page_size );
+
+    size_t index = 0;
+    for( auto &it : g->m.i_at( pos ) ) {
+        column.add_entry( inventory_entry( item_location( map_cursor( pos ), &it ), 1,
+                                           categories[index++ % categories.size()] ) );
+    }
+    REQUIRE( index == 4 * ids.size() );
+    column.prepare_paging();
+
+    size_t items = 0;
+    const inventory_entry *previous = nullptr;
+    for( size_t i = 0; i < column.entries.size(); i++ ) {
+        const inventory_entry &entry = column.entries[i];
+        CHECK( column.page_of( entry ) == i / page_size );
+        if( i % page_size == 0 ) {
+            // Every page starts with the title of its category
+            CHECK( entry.is_category() );
+        }
+        if( !entry.is_item() ) {
+            continue;
+        }
+        items++;
+        if( previous != nullptr ) {
+            const item_category *prev_cat = previous->get_category_ptr();
+            const item_category *cat = entry.get_category_ptr();
+            if( prev_cat == cat ) {
+                CHECK( previous->get_sort_name() <= entry.get_sort_name() );
+            } else {
+                // Equal ranks keep the order in which the categories were added
+                CHECK( ( prev_cat == &cat_first && cat == &cat_second ) ==
+                       ( prev_cat->sort_rank == cat->sort_rank ) );
+                CHECK( prev_cat->sort_rank <= cat->sort_rank );
+            }
+        }
+        previous = &entry;
+    }
+    CHECK( items == index );
+    CHECK( column.entries.front().get_category_ptr() == &cat_first );
+    CHECK( previous->get_category_ptr() == &cat_late );
+
+    // Removing and adding an entry again is allowed, the column reorders it
+    const inventory_entry removed = *previous;
+    column.remove_entry( removed );
+    column.add_entry( removed );
+    column.prepare_paging();
+    CHECK( column.entries.back() == removed );
+
+    column.clear();
+    CHECK( column.empty() );
+    g->m.i_clear( pos );
+}
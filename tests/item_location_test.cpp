@@ -0,0 +1,166 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "item.h"
+#include "item_location.h"
+#include "json.h"
+#include "map.h"
+#include "map_selector.h"
+#include "player.h"
+#include "vehicle.h"
+#include "vehicle_selector.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+static std::string serialize( const item_location &loc )
+{
+    std::ostringstream out;
+    {
+        JsonOut jsout( out );
+        loc.serialize( jsout );
+    }
+    return out.str();
+}
+
+static item_location deserialize( const std::string &text )
+{
+    std::istringstream in( text );
+    JsonIn jsin( in );
+    item_location loc;
+    loc.deserialize( jsin );
+    return loc;
+}
+
+TEST_CASE( "items_have_unique_ids", "[item][item_location]" ) {
+    item rock( "rock" );
+    item hammer( "hammer" );
+    CHECK( rock.uid > 0 );
+    CHECK( rock.uid != hammer.uid );
+
+    const item copy = rock;
+    CHECK( copy.uid == rock.uid );
+
+    item ammo( "9mm", calendar::turn, 10 );
+    const item part = ammo.split( 3 );
+    CHECK( part.uid != ammo.uid );
+
+    std::ostringstream out;
+    {
+        JsonOut jsout( out );
+        hammer.serialize( jsout );
+    }
+    std::istringstream in( out.str() );
+    JsonIn jsin( in );
+    item loaded;
+    loaded.deserialize( jsin );
+    CHECK( loaded.uid == hammer.uid );
+    CHECK( item::new_uid() > hammer.uid );
+
+    std::istringstream legacy( "{\"typeid\":\"rock\",\"bday\":0}" );
+    JsonIn legacy_in( legacy );
+    item migrated;
+    migrated.deserialize( legacy_in );
+    CHECK( migrated.uid > hammer.uid );
+}
+
+TEST_CASE( "item_location_on_map_survives_reordering", "[item_location]" ) {
+    const tripoint pos = g->u.pos() + tripoint( 20, 5, 0 );
+    g->m.i_clear( pos );
+    g->m.add_item( pos, item( "rock" ) );
+    item &hammer = g->m.add_item( pos, item( "hammer" ) );
+    g->m.add_item( pos, item( "bottle_plastic" ) );
+    const long uid = hammer.uid;
+
+    const std::string text = serialize( item_location( map_cursor( pos ), &hammer ) );
+    CHECK( text.find( "\"idx\"" ) == std::string::npos );
+
+    auto stack = g->m.i_at( pos );
+    stack.erase( stack.begin() );
+    REQUIRE( stack.size() == 2 );
+
+    item_location loc = deserialize( text );
+    REQUIRE( loc );
+    CHECK( loc->uid == uid );
+    CHECK( loc->typeId() == "hammer" );
+    CHECK( loc.get_item() == &stack.front() );
+
+    SECTION( "Locations from old saves are resolved by index" ) {
+        std::ostringstream legacy;
+        legacy << "{\"type\":\"map\",\"pos\":[" << pos.x << "," << pos.y << "," << pos.z <<
+               "],\"idx\":1}";
+        item_location old = deserialize( legacy.str() );
+        REQUIRE( old );
+        CHECK( old->typeId() == "bottle_plastic" );
+    }
+
+    g->m.i_clear( pos );
+}
+
+TEST_CASE( "item_location_on_person_survives_reordering", "[item_location]" ) {
+    player &u = g->u;
+    u.remove_weapon();
+    u.inv.clear();
+    u.worn.clear();
+
+    u.i_add( item( "rock" ) );
+    item &backpack = u.i_add( item( "backpack" ) );
+    const long uid = backpack.emplace_back( "hammer" ).uid;
+    u.i_add( item( "bottle_plastic" ) );
+
+    item *hammer = &backpack.contents.back();
+    const std::string text = serialize( item_location( u, hammer ) );
+
+    u.remove_items_with( []( const item & e ) {
+        return e.typeId() == "rock";
+    } );
+
+    item_location loc = deserialize( text );
+    REQUIRE( loc );
+    CHECK( loc->uid == uid );
+    CHECK( loc->typeId() == "hammer" );
+    CHECK( u.has_item( *loc ) );
+
+    u.inv.clear();
+}
+
+TEST_CASE( "item_location_on_vehicle_survives_reordering", "[item_location]" ) {
+    const tripoint pos = g->u.pos() + tripoint( 25, 15, 0 );
+    vehicle *veh = g->m.add_vehicle( vproto_id( "shopping_cart" ), pos, 0 );
+    REQUIRE( veh != nullptr );
+    const int part = veh->part_with_feature( 0, "CARGO" );
+    REQUIRE( part >= 0 );
+
+    REQUIRE( veh->add_item( part, item( "rock" ) ) );
+    REQUIRE( veh->add_item( part, item( "hammer" ) ) );
+    REQUIRE( veh->add_item( part, item( "bottle_plastic" ) ) );
+    vehicle_cursor cur( *veh, part );
+    auto items = veh->get_items( part );
+    item *hammer = &*std::find_if( items.begin(), items.end(), []( const item & e ) {
+        return e.typeId() == "hammer";
+    } );
+    const long uid = hammer->uid;
+
+    const std::string text = serialize( item_location( cur, hammer ) );
+    const item_location part_base = veh->part_base( part );
+    const std::string base_text = serialize( part_base );
+
+    for( auto it = items.begin(); it != items.end(); ++it ) {
+        if( it->typeId() == "rock" ) {
+            items.erase( it );
+            break;
+        }
+    }
+
+    item_location loc = deserialize( text );
+    REQUIRE( loc );
+    CHECK( loc->uid == uid );
+    CHECK( loc->typeId() == "hammer" );
+
+    item_location base = deserialize( base_text );
+    REQUIRE( base );
+    CHECK( base.get_item() == part_base.get_item() );
+
+    g->m.destroy_vehicle( veh );
+}
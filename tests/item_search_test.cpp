@@ -0,0 +1,44 @@
+#include "catch/catch.hpp"
+
+#include "catacharset.h"
+#include "cata_utility.h"
+#include "item.h"
+#include "item_search.h"
+#include "material.h"
+
+TEST_CASE( "fold_case_knows_more_than_ascii", "[search]" ) {
+    CHECK( fold_case( "Rock HAMMER 42" ) == "rock hammer 42" );
+    CHECK( fold_case( "ÄPFEL Über" ) == "äpfel über" );
+    CHECK( fold_case( "ŁÓDŹ ŻÓŁW" ) == "łódź żółw" );
+    CHECK( fold_case( "ЁЛКА Топор" ) == "ёлка топор" );
+    CHECK( fold_case( "ΣΟΦΙΑ" ) == "σοφια" );
+    // No case, or not even valid UTF-8: left alone.
+    CHECK( fold_case( "斧 ×" ) == "斧 ×" );
+    CHECK( fold_case( std::string( "A\xff" "B" ) ) == std::string( "a\xff" "b" ) );
+
+    CHECK( lcmatch( "Большой ТОПОР", "топор" ) );
+    CHECK( lcmatch( "Hammer", "MM" ) );
+    CHECK_FALSE( lcmatch( "Hammer", "mn" ) );
+}
+
+TEST_CASE( "item_filters_are_compiled_once", "[search]" ) {
+    const item rock( "rock" );
+    const item hammer( "hammer" );
+    const auto by_name = item_filter_from_string( "ROCK" );
+    CHECK( by_name( rock ) );
+    CHECK_FALSE( by_name( hammer ) );
+
+    const auto excluded = item_filter_from_string( "-rock" );
+    CHECK_FALSE( excluded( rock ) );
+    CHECK( excluded( hammer ) );
+
+    const auto any = item_filter_from_string( "rock,hammer" );
+    CHECK( any( rock ) );
+    CHECK( any( hammer ) );
+
+    const auto by_category = item_filter_from_string( "c:" + rock.get_category().name );
+    CHECK( by_category( rock ) );
+
+    const auto by_material = item_filter_from_string( "m:" + rock.made_of().front()->name() );
+    CHECK( by_material( rock ) );
+}
@@ -0,0 +1,159 @@
+#include "catch/catch.hpp"
+
+#include "json.h"
+#include "npc.h"
+#include "overmap.h"
+
+#include <clocale>
+#include <fstream>
+#include <limits>
+#include <locale>
+#include <regex>
+#include <sstream>
+
+static std::string read_file( const std::string &path )
+{
+    std::ifstream fin( path.c_str(), std::ifstream::binary );
+    REQUIRE( fin.is_open() );
+    std::ostringstream content;
+    content << fin.rdbuf();
+    return content.str();
+}
+
+// Formats the value the way the stream based JsonOut used to.
+template<typename T>
+static std::string stream_formatted( T val )
+{
+    std::ostringstream ref;
+    ref.imbue( std::locale::classic() );
+    ref.setf( std::ios_base::showpoint );
+    ref.setf( std::ios_base::dec, std::ostream::basefield );
+    ref.setf( std::ios_base::fixed, std::ostream::floatfield );
+    ref.setf( std::ios_base::boolalpha );
+    ref << val;
+    return ref.str();
+}
+
+template<typename T>
+static std::string json_formatted( T val )
+{
+    std::ostringstream out;
+    {
+        JsonOut json( out );
+        json.write( val );
+    }
+    return out.str();
+}
+
+template<typename T>
+static void check_numbers( const std::vector<T> &values )
+{
+    for( const T val : values ) {
+        CHECK( json_formatted( val ) == stream_formatted( val ) );
+    }
+}
+
+static void check_all_numbers()
+{
+    check_numbers<int>( { 0, 1, -1, 9, 10, 99, -100, 123456789, std::numeric_limits<int>::max(), std::numeric_limits<int>::min() } );
+    check_numbers<long>( { 0, -7, std::numeric_limits<long>::max(), std::numeric_limits<long>::min() } );
+    check_numbers<long long>( { std::numeric_limits<long long>::max(), std::numeric_limits<long long>::min() } );
+    check_numbers<unsigned>( { 0, 42, std::numeric_limits<unsigned>::max() } );
+    check_numbers<unsigned long>( { 0, std::numeric_limits<unsigned long>::max() } );
+    check_numbers<unsigned long long>( { std::numeric_limits<unsigned long long>::max() } );
+    check_numbers<short>( { -32768, 32767 } );
+    check_numbers<bool>( { true, false } );
+    check_numbers<float>( { 0.0f, -0.0f, 0.1f, 1.5f, -2.25f, 1e-7f, 3.4e38f, 123456.789f } );
+    check_numbers<double>( { 0.0, 0.1, -0.5, 1.0 / 3.0, 0.0000005, 0.0000015, 1e20, -1e300,
+                             std::numeric_limits<double>::max(), std::numeric_limits<double>::infinity() } );
+}
+
+TEST_CASE( "json_out_numbers_match_stream_formatting", "[json]" ) {
+    check_all_numbers();
+
+    SECTION( "with a global locale using a decimal comma" ) {
+        const std::string previous = setlocale( LC_NUMERIC, nullptr );
+        if( setlocale( LC_NUMERIC, "de_DE.UTF-8" ) != nullptr ||
+            setlocale( LC_NUMERIC, "de_DE" ) != nullptr ) {
+            check_all_numbers();
+        }
+        setlocale( LC_NUMERIC, previous.c_str() );
+    }
+}
+
+TEST_CASE( "json_out_escapes_strings", "[json]" ) {
+    CHECK( json_formatted( "plain text/with slash" ) == "\"plain text/with slash\"" );
+    CHECK( json_formatted( std::string( "quote\" backslash\\ tab\t" ) ) ==
+           "\"quote\\\" backslash\\\\ tab\\t\"" );
+    CHECK( json_formatted( std::string( "\b\f\n\r\x01\x1f\x7f" ) ) ==
+           "\"\\b\\f\\n\\r\\u0001\\u001F\x7f\"" );
+    CHECK( json_formatted( std::string( "\xe2\x98\xba" ) ) == "\"\xe2\x98\xba\"" );
+    CHECK( json_formatted( std::string() ) == "\"\"" );
+}
+
+TEST_CASE( "json_out_pretty_print", "[json]" ) {
+    std::ostringstream out;
+    {
+        JsonOut json( out, true );
+        json.start_object();
+        json.member( "name", "value" );
+        json.member( "list" );
+        json.start_array();
+        json.write( 1 );
+        json.write( 2.5 );
+        json.end_array();
+        json.null_member( "nothing" );
+        json.end_object();
+    }
+    CHECK( out.str() ==
+           "{\n  \"name\": \"value\",\n  \"list\": [\n    1,\n    2.500000\n  ],\n  \"nothing\": null\n}" );
+}
+
+// The fixtures predate item uids, the items get new ones when loading.
+static std::string without_uids( const std::string &json )
+{
+    static const std::regex uid_member( ",\\s*\"uid\": ?[0-9]+" );
+    return std::regex_replace( json, uid_member, "" );
+}
+
+static std::string pretty_npcs( const overmap &om )
+{
+    std::ostringstream out;
+    {
+        JsonOut json( out, true );
+        json.start_array();
+        for( const npc *guy : om.npcs ) {
+            json.write( *guy );
+        }
+        json.end_array();
+    }
+    return out.str();
+}
+
+TEST_CASE( "json_out_matches_save_fixtures", "[json]" ) {
+    overmap test_map;
+    {
+        std::ifstream fin( "tests/data/legacy_0.C_overmap.sav", std::ifstream::binary );
+        REQUIRE( fin.is_open() );
+        test_map.unserialize( fin );
+    }
+    // Legacy saves have no city names, they are picked randomly when loading.
+    for( auto &c : test_map.cities ) {
+        c.name = "Dover-Foxcroft";
+    }
+
+    // The fixtures were written with the stream based JsonOut.
+    const std::string expected_overmap = read_file( "tests/data/legacy_0.C_overmap.json" );
+    std::ostringstream overmap_out;
+    test_map.serialize( overmap_out );
+    CHECK( without_uids( overmap_out.str() ) == expected_overmap );
+
+    const std::string expected_npcs = read_file( "tests/data/legacy_0.C_npcs.json" );
+    CHECK( without_uids( pretty_npcs( test_map ) ) == expected_npcs );
+
+    // Monsters are kept in a hash map, their order changes when loading, the npcs do not.
+    overmap reloaded;
+    std::istringstream fin( overmap_out.str() );
+    reloaded.unserialize( fin );
+    CHECK( pretty_npcs( reloaded ) == pretty_npcs( test_map ) );
+}
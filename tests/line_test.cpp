@@ -1,10 +1,15 @@
 #include "catch/catch.hpp"
 
+#include "game.h"
 #include "line.h"
+#include "map.h"
+#include "mapdata.h"
+#include "player.h"
 #include "rng.h"
 
 #include "stdio.h"
 #include <chrono>
+#include <random>
 
 #define SGN(a) (((a)<0) ? -1 : 1)
 // Compare all future line_to implementations to the canonical one.
@@ -363,3 +368,277 @@ TEST_CASE("line_to_regression") {
 TEST_CASE("line_to_performance", "[.]") {
     line_to_comparison(10000);
 }
+
+#undef SGN
+#define SGN(a) (((a)<0) ? -1 : (((a)>0) ? 1 : 0))
+// The 3D bresenham before it was split into bresenham_state, the new one must match it exactly.
+static void reference_bresenham( const tripoint &loc1, const tripoint &loc2, int t, int t2,
+                                 const std::function<bool( const tripoint & )> &interact )
+{
+    const int dx = loc2.x - loc1.x;
+    const int dy = loc2.y - loc1.y;
+    const int dz = loc2.z - loc1.z;
+    const int sx = SGN( dx );
+    const int sy = SGN( dy );
+    const int sz = SGN( dz );
+    const int ax = abs( dx ) * 2;
+    const int ay = abs( dy ) * 2;
+    const int az = abs( dz ) * 2;
+
+    tripoint cur( loc1 );
+    if( az == 0 ) {
+        if( ax == ay ) {
+            while( cur.x != loc2.x ) {
+                cur.y += sy;
+                cur.x += sx;
+                if( !interact( cur ) ) {
+                    break;
+                }
+            }
+        } else if( ax > ay ) {
+            while( cur.x != loc2.x ) {
+                if( t > 0 ) {
+                    cur.y += sy;
+                    t -= ax;
+                }
+                cur.x += sx;
+                t += ay;
+                if( !interact( cur ) ) {
+                    break;
+                }
+            }
+        } else {
+            while( cur.y != loc2.y ) {
+                if( t > 0 ) {
+                    cur.x += sx;
+                    t -= ay;
+                }
+                cur.y += sy;
+                t += ax;
+                if( !interact( cur ) ) {
+                    break;
+                }
+            }
+        }
+    } else if( ax == ay && ay == az ) {
+        while( cur.x != loc2.x ) {
+            cur.z += sz;
+            cur.y += sy;
+            cur.x += sx;
+            if( !interact( cur ) ) {
+                break;
+            }
+        }
+    } else if( az > ax && az > ay ) {
+        while( cur.z != loc2.z ) {
+            if( t > 0 ) {
+                cur.x += sx;
+                t -= az;
+            }
+            if( t2 > 0 ) {
+                cur.y += sy;
+                t2 -= az;
+            }
+            cur.z += sz;
+            t += ax;
+            t2 += ay;
+            if( !interact( cur ) ) {
+                break;
+            }
+        }
+    } else if( ax == ay ) {
+        while( cur.x != loc2.x ) {
+            if( t > 0 ) {
+                cur.z += sz;
+                t -= ax;
+            }
+            cur.y += sy;
+            cur.x += sx;
+            t += az;
+            if( !interact( cur ) ) {
+                break;
+            }
+        }
+    } else if( ax > ay ) {
+        while( cur.x != loc2.x ) {
+            if( t > 0 ) {
+                cur.y += sy;
+                t -= ax;
+            }
+            if( t2 > 0 ) {
+                cur.z += sz;
+                t2 -= ax;
+            }
+            cur.x += sx;
+            t += ay;
+            t2 += az;
+            if( !interact( cur ) ) {
+                break;
+            }
+        }
+    } else {
+        while( cur.y != loc2.y ) {
+            if( t > 0 ) {
+                cur.x += sx;
+                t -= ay;
+            }
+            if( t2 > 0 ) {
+                cur.z += sz;
+                t2 -= ay;
+            }
+            cur.y += sy;
+            t += ax;
+            t2 += az;
+            if( !interact( cur ) ) {
+                break;
+            }
+        }
+    }
+}
+
+static std::vector<tripoint> reference_line( const tripoint &from, const tripoint &to, int t, int t2 )
+{
+    std::vector<tripoint> line;
+    reference_bresenham( from, to, t, t2, [&line]( const tripoint & p ) {
+        line.push_back( p );
+        return true;
+    } );
+    return line;
+}
+
+TEST_CASE( "line_kernels_match_the_reference_bresenham", "[line]" ) {
+    std::minstd_rand generator( 1234 );
+    const auto random_in = [&generator]( int lo, int hi ) {
+        return lo + static_cast<int>( generator() % ( hi - lo + 1 ) );
+    };
+    for( int i = 0; i < 20000; i++ ) {
+        // Flat lines, steep lines and mostly vertical ones.
+        const int zrange = i % 3 == 0 ? 0 : i % 3 == 1 ? 2 : 30;
+        const tripoint from( random_in( -30, 30 ), random_in( -30, 30 ), random_in( -zrange, zrange ) );
+        const tripoint to = i % 50 == 0 ? from :
+                            tripoint( random_in( -30, 30 ), random_in( -30, 30 ), random_in( -zrange, zrange ) );
+        const int t = random_in( -60, 60 );
+        const int t2 = random_in( -60, 60 );
+        INFO( "from " << from.x << "," << from.y << "," << from.z << " to " << to.x << "," << to.y << "," <<
+              to.z << " t " << t << " t2 " << t2 );
+
+        const std::vector<tripoint> expected = reference_line( from, to, t, t2 );
+        std::vector<tripoint> visited;
+        bresenham( from, to, t, t2, [&visited]( const tripoint & p ) {
+            visited.push_back( p );
+            return true;
+        } );
+        REQUIRE( visited == expected );
+
+        const line_view view( from, to, t, t2 );
+        CHECK( view.size() == expected.size() );
+        CHECK( std::vector<tripoint>( view.begin(), view.end() ) == expected );
+
+        if( from == to ) {
+            CHECK( line_to( from, to, t, t2 ) == std::vector<tripoint>( 1, from ) );
+        } else {
+            CHECK( line_to( from, to, t, t2 ) == expected );
+        }
+
+        if( from.z == to.z ) {
+            std::vector<point> flat;
+            bresenham( from.x, from.y, to.x, to.y, t, [&flat]( const point & p ) {
+                flat.push_back( p );
+                return true;
+            } );
+            const std::vector<tripoint> expected_flat = reference_line( from, tripoint( to.x, to.y, from.z ), t,
+                    0 );
+            REQUIRE( flat.size() == expected_flat.size() );
+            for( size_t j = 0; j < flat.size(); j++ ) {
+                CHECK( flat[j] == point( expected_flat[j].x, expected_flat[j].y ) );
+            }
+        }
+
+        // Stopping early visits the same squares.
+        if( expected.size() > 2 ) {
+            const size_t stop = random_in( 1, expected.size() - 1 );
+            std::vector<tripoint> partial;
+            bresenham( from, to, t, t2, [&partial, stop]( const tripoint & p ) {
+                partial.push_back( p );
+                return partial.size() < stop;
+            } );
+            CHECK( partial == std::vector<tripoint>( expected.begin(), expected.begin() + stop ) );
+        }
+    }
+}
+
+// What map::sees did before it read the transparency cache directly.
+static bool reference_sees( const map &m, const tripoint &from, const tripoint &to, int slope )
+{
+    bool visible = true;
+    reference_bresenham( from, to, slope, 0, [&m, &visible, &to]( const tripoint & p ) {
+        if( p == to ) {
+            return false;
+        }
+        if( !m.trans( p ) ) {
+            visible = false;
+            return false;
+        }
+        return true;
+    } );
+    return visible;
+}
+
+// What map::find_clear_path returns, based on reference_sees.
+static std::vector<tripoint> reference_clear_path( const map &m, const tripoint &from,
+        const tripoint &to )
+{
+    const int ax = std::abs( to.x - from.x ) * 2;
+    const int ay = std::abs( to.y - from.y ) * 2;
+    const int ideal_start_offset = std::min( ax, ay ) - std::max( ax, ay ) / 2;
+    const int start_sign = ( ideal_start_offset > 0 ) - ( ideal_start_offset < 0 );
+    const int max_start_offset = std::abs( ideal_start_offset ) * 2 + 1;
+    for( int horizontal_offset = -1; horizontal_offset <= max_start_offset; ++horizontal_offset ) {
+        const int candidate_offset = horizontal_offset * start_sign;
+        if( reference_sees( m, from, to, candidate_offset ) ) {
+            return line_to( from, to, candidate_offset, 0 );
+        }
+    }
+    return line_to( from, to, ideal_start_offset, 0 );
+}
+
+TEST_CASE( "map_sees_matches_the_reference_line_of_sight", "[line][map]" ) {
+    map &m = g->m;
+    const int z = g->u.posz();
+    const tripoint from( SEEX * 4, SEEY * 4, z );
+    const tripoint to = from + tripoint( 30, 30, 0 );
+    std::minstd_rand generator( 99 );
+    const auto random_in = [&generator]( int lo, int hi ) {
+        return lo + static_cast<int>( generator() % ( hi - lo + 1 ) );
+    };
+
+    std::vector<std::pair<tripoint, ter_id>> replaced;
+    for( int i = 0; i < 120; i++ ) {
+        const tripoint p( random_in( from.x, to.x ), random_in( from.y, to.y ), z );
+        replaced.emplace_back( p, m.ter( p ) );
+        m.ter_set( p, t_wall );
+    }
+    m.build_map_cache( z, true );
+
+    int seen = 0;
+    for( int i = 0; i < 5000; i++ ) {
+        const tripoint f( random_in( from.x, to.x ), random_in( from.y, to.y ), z );
+        const tripoint t( random_in( from.x, to.x ), random_in( from.y, to.y ), z );
+        INFO( "from " << f.x << "," << f.y << " to " << t.x << "," << t.y );
+        const bool expected = reference_sees( m, f, t, 0 );
+        CHECK( m.sees( f, t, -1 ) == expected );
+        seen += expected;
+        if( i % 10 == 0 ) {
+            // Tries the other slopes through the internal sees overload.
+            CHECK( m.find_clear_path( f, t ) == reference_clear_path( m, f, t ) );
+        }
+    }
+    // The walls have to block some lines and not others for this to test anything.
+    CHECK( seen > 500 );
+    CHECK( seen < 4500 );
+
+    for( auto it = replaced.rbegin(); it != replaced.rend(); ++it ) {
+        m.ter_set( it->first, it->second );
+    }
+    m.build_map_cache( z, true );
+}
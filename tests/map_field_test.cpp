@@ -0,0 +1,78 @@
+#include "catch/catch.hpp"
+
+#include "field.h"
+#include "game.h"
+#include "map.h"
+#include "map_iterator.h"
+#include "player.h"
+
+#include <array>
+#include <random>
+#include <vector>
+
+static const std::array<field_id, 5> test_fields = {{
+        fd_smoke, fd_tear_gas, fd_cigsmoke, fd_blood, fd_bile
+    }
+};
+
+static std::vector<float> transparency_cache( const map &m, const int z )
+{
+    const auto &cache = m.get_cache_ref( z ).transparency_cache;
+    return std::vector<float>( &cache[0][0], &cache[0][0] + MAPSIZE * SEEX * MAPSIZE * SEEY );
+}
+
+static void clear_test_fields( map &m, const tripoint &from, const tripoint &to )
+{
+    for( const tripoint &p : m.points_in_rectangle( from, to ) ) {
+        for( const field_id type : test_fields ) {
+            m.remove_field( p, type );
+        }
+    }
+}
+
+TEST_CASE( "transparent_fields_keep_the_transparency_cache_clean", "[map][field]" ) {
+    map &m = g->m;
+    const int z = g->u.posz();
+    const tripoint p = g->u.pos() + tripoint( 20, 0, 0 );
+    m.build_map_cache( z, true );
+    REQUIRE_FALSE( m.get_cache_ref( z ).transparency_cache_dirty );
+
+    m.add_field( p, fd_blood, 1 );
+    CHECK_FALSE( m.get_cache_ref( z ).transparency_cache_dirty );
+    CHECK_FALSE( m.process_fields() );
+    CHECK_FALSE( m.get_cache_ref( z ).transparency_cache_dirty );
+
+    clear_test_fields( m, p, p );
+}
+
+TEST_CASE( "field_processing_updates_the_transparency_cache_exactly", "[map][field]" ) {
+    map &m = g->m;
+    const int z = g->u.posz();
+    // Far enough from the player to not affect them
+    const tripoint from = g->u.pos() + tripoint( 15, -10, 0 );
+    const tripoint to = g->u.pos() + tripoint( 35, 10, 0 );
+    std::minstd_rand generator( 7 );
+    const auto random_in = [&generator]( int lo, int hi ) {
+        return lo + static_cast<int>( generator() % ( hi - lo + 1 ) );
+    };
+
+    m.build_map_cache( z, true );
+    for( int turn = 0; turn < 30; turn++ ) {
+        for( int i = 0; i < 3; i++ ) {
+            const tripoint p( random_in( from.x, to.x ), random_in( from.y, to.y ), z );
+            m.add_field( p, test_fields[random_in( 0, test_fields.size() - 1 )], random_in( 1, 3 ) );
+        }
+        m.process_fields();
+
+        m.build_map_cache( z, true );
+        const std::vector<float> updated = transparency_cache( m, z );
+        m.set_transparency_cache_dirty( z );
+        m.build_map_cache( z, true );
+        const std::vector<float> rebuilt = transparency_cache( m, z );
+        INFO( "turn " << turn );
+        CHECK( updated == rebuilt );
+    }
+
+    clear_test_fields( m, from, to );
+    m.build_map_cache( z, true );
+}
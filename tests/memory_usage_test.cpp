@@ -0,0 +1,59 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "memory_usage.h"
+#include "player.h"
+#include "submap.h"
+
+#include <algorithm>
+
+TEST_CASE( "item_memory_estimate_includes_contents", "[memory]" ) {
+    item bag( "bag_plastic" );
+    const size_t empty = bag.estimate_memory_usage();
+    CHECK( empty >= sizeof( item ) );
+
+    bag.contents.emplace_back( "rock" );
+    const size_t one = bag.estimate_memory_usage();
+    CHECK( one >= empty + sizeof( item ) );
+
+    bag.contents.back().set_var( "some_variable", "some rather long value that is not inlined" );
+    CHECK( bag.estimate_memory_usage() > one );
+}
+
+TEST_CASE( "submap_memory_estimate_grows_with_items", "[memory]" ) {
+    submap sm;
+    const size_t empty = sm.estimate_memory_usage();
+    CHECK( empty >= sizeof( submap ) );
+
+    for( int i = 0; i < 10; i++ ) {
+        sm.itm[0][0].emplace_back( "rock" );
+    }
+    CHECK( sm.estimate_memory_usage() >= empty + 10 * sizeof( item ) );
+}
+
+TEST_CASE( "memory_report_tracks_peaks", "[memory]" ) {
+    const auto first = memory_usage::report();
+    REQUIRE_FALSE( first.empty() );
+    for( const auto &row : first ) {
+        INFO( row.name );
+        CHECK( row.peak >= row.current );
+    }
+
+    const auto submaps = std::find_if( first.begin(), first.end(), []( const memory_usage::subsystem_usage & row ) {
+        return row.name.find( "submaps" ) == 0;
+    } );
+    REQUIRE( submaps != first.end() );
+    // The test map is loaded, so the map buffer can not be empty.
+    CHECK( submaps->count > 0 );
+    CHECK( submaps->current >= submaps->count * sizeof( submap ) );
+
+    // Peaks never decrease between reports.
+    const auto second = memory_usage::report();
+    REQUIRE( second.size() == first.size() );
+    for( size_t i = 0; i < first.size(); i++ ) {
+        CHECK( second[i].peak >= first[i].peak );
+    }
+}
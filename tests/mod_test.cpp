@@ -1,9 +1,17 @@
 #include "catch/catch.hpp"
 
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "game.h"
+#include "init.h"
 #include "item.h"
+#include "item_factory.h"
+#include "mtype.h"
 #include "worldfactory.h"
 
 #include <algorithm>
+#include <string>
+#include <vector>
 
 TEST_CASE("Boat mod is loaded correctly or not at all") {
     const auto &mods = world_generator->active_world->active_mod_order;
@@ -13,3 +21,46 @@ TEST_CASE("Boat mod is loaded correctly or not at all") {
         REQUIRE( !item::type_is_defined( "inflatable_boat" ) );
     }
 }
+
+TEST_CASE( "world_data_is_reused_while_its_files_are_unchanged", "[mods]" ) {
+    WORLDPTR world = world_generator->active_world;
+    const DynamicDataLoader &loader = DynamicDataLoader::get_instance();
+    const std::string fingerprint = g->data_fingerprint( world );
+    REQUIRE_FALSE( fingerprint.empty() );
+    // The test world was loaded cold by load_world_data
+    REQUIRE( loader.loaded_fingerprint() == fingerprint );
+
+    // Runtime item types created by earlier tests are replaced by the world's artifacts
+    g->load_world_data( world );
+    const itype *rock = item::find_type( "rock" );
+    const mtype *zombie = &mtype_id( "mon_zombie" ).obj();
+    const size_t item_types = item_controller->all().size();
+
+    SECTION( "Loading the same data again keeps the registries of the cold load" ) {
+        g->load_world_data( world );
+        CHECK( loader.loaded_fingerprint() == fingerprint );
+        CHECK( item::find_type( "rock" ) == rock );
+        CHECK( &mtype_id( "mon_zombie" ).obj() == zombie );
+        CHECK( item_controller->all().size() == item_types );
+    }
+
+    SECTION( "Changed files change the fingerprint" ) {
+        const std::string dir = world->world_path + "/mods";
+        REQUIRE( assure_dir_exist( dir ) );
+        const std::string path = dir + "/fingerprint_test.json";
+        REQUIRE( write_to_file( path, []( std::ostream & fout ) {
+            fout << "[]";
+        }, nullptr ) );
+        CHECK( g->data_fingerprint( world ) != fingerprint );
+        remove_file( path );
+        CHECK( g->data_fingerprint( world ) == fingerprint );
+    }
+
+    SECTION( "A different mod list changes the fingerprint" ) {
+        const std::vector<std::string> mods = world->active_mod_order;
+        world->active_mod_order.push_back( "no_such_mod" );
+        CHECK( g->data_fingerprint( world ) != fingerprint );
+        world->active_mod_order = mods;
+        CHECK( g->data_fingerprint( world ) == fingerprint );
+    }
+}
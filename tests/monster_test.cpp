@@ -369,3 +369,48 @@ TEST_CASE("monster_speed_trig") {
     trigdist = true;
     monster_check();
 }
+
+TEST_CASE("monster_ai_low_detail_resumes_when_promoted") {
+    clear_map();
+    const int lod_distance = get_option<int>( "MONSTER_AI_LOD_DISTANCE" );
+    const int lod_interval = get_option<int>( "MONSTER_AI_LOD_INTERVAL" );
+    REQUIRE( lod_interval > 1 );
+
+    g->u.setpos( { 10, 10, 0 } );
+    const tripoint start( 20 + lod_distance, 10, 0 );
+    monster &critter = spawn_test_monster( "mon_zombie_dog", start );
+    critter.set_dest( start + tripoint( 0, 30, 0 ) );
+    critter.set_moves( 0 );
+    const int speed = critter.get_speed();
+
+    // Far away it waits, collecting its moves...
+    for( int turn = 1; turn < lod_interval; turn++ ) {
+        g->monmove();
+        CHECK( critter.pos() == start );
+        CHECK( critter.moves == turn * speed );
+    }
+    // ...and spends all of them at once.
+    g->monmove();
+    CHECK( critter.moves <= 0 );
+    CHECK( rl_dist( critter.pos(), start ) > 1 );
+    CHECK( critter.ai_deferred_turns == 0 );
+
+    g->monmove();
+    const tripoint deferred_pos = critter.pos();
+    const int deferred_moves = critter.moves;
+    CHECK( deferred_moves > 0 );
+
+    // Getting close to it promotes it, the collected moves are spent right away.
+    g->u.setpos( deferred_pos + tripoint( -5, 0, 0 ) );
+    g->monmove();
+    CHECK( critter.ai_deferred_turns == -1 );
+    CHECK( critter.moves <= 0 );
+    CHECK( critter.pos() != deferred_pos );
+
+    // From now on it acts every turn (it may be attacking, so it doesn't have to move).
+    g->monmove();
+    CHECK( critter.ai_deferred_turns == -1 );
+    CHECK( critter.moves <= 0 );
+
+    g->remove_zombie( 0 );
+}
@@ -178,3 +178,89 @@ TEST_CASE("snippet-tag-test")
     CHECK( SNIPPET.all_ids_from_category( "<mywp>" ).empty() );
     CHECK( SNIPPET.all_ids_from_category( "<ammo>" ).empty() );
 }
+
+TEST_CASE("npc-weapon-value-cache")
+{
+    npc test_npc = create_model();
+    const item knife( "knife_combat" );
+    item pipe( "pipe" );
+
+    const double knife_value = test_npc.cached_weapon_value( knife );
+    CHECK( knife_value == Approx( test_npc.weapon_value( knife ) ) );
+    const int version = test_npc.item_values_version();
+
+    SECTION("Values are reused while nothing changes") {
+        CHECK( test_npc.cached_weapon_value( knife ) == knife_value );
+        CHECK( test_npc.cached_weapon_value( pipe ) == Approx( test_npc.weapon_value( pipe ) ) );
+        CHECK( test_npc.item_values_version() == version );
+    }
+
+    SECTION("Changed items are evaluated again") {
+        const double pipe_value = test_npc.cached_weapon_value( pipe );
+        pipe.set_damage( pipe.max_damage() );
+        CHECK( test_npc.cached_weapon_value( pipe ) == Approx( test_npc.weapon_value( pipe ) ) );
+        CHECK( test_npc.cached_weapon_value( pipe ) != Approx( pipe_value ) );
+        CHECK( test_npc.item_values_version() == version );
+    }
+
+    SECTION("Skill and stat changes drop all values") {
+        test_npc.set_skill_level( skill_id( "melee" ), 10 );
+        CHECK( test_npc.item_values_version() != version );
+        CHECK( test_npc.cached_weapon_value( knife ) == Approx( test_npc.weapon_value( knife ) ) );
+
+        const int skill_version = test_npc.item_values_version();
+        test_npc.str_max += 6;
+        CHECK( test_npc.item_values_version() != skill_version );
+        CHECK( test_npc.cached_weapon_value( knife ) == Approx( test_npc.weapon_value( knife ) ) );
+    }
+}
+
+TEST_CASE("npc-plan-cache")
+{
+    g->clear_zombies();
+    npc guy = create_model();
+    guy.weapon = item();
+    guy.inv.clear();
+    guy.worn.clear();
+    guy.has_new_items = false;
+    guy.attitude = NPCATT_FOLLOW;
+    guy.setpos( g->u.pos() + tripoint( 2, 0, 0 ) );
+    const calendar start = calendar::turn;
+
+    guy.move();
+    REQUIRE( guy.has_valid_plan() );
+
+    SECTION("The plan is kept while nothing changes") {
+        guy.move();
+        CHECK( guy.has_valid_plan() );
+    }
+
+    SECTION("Damage invalidates the plan") {
+        guy.apply_damage( nullptr, bp_torso, 5 );
+        CHECK_FALSE( guy.has_valid_plan() );
+    }
+
+    SECTION("Crossing a needs threshold invalidates the plan") {
+        guy.set_thirst( 50 );
+        CHECK_FALSE( guy.has_valid_plan() );
+    }
+
+    SECTION("A new hostile creature invalidates the plan") {
+        REQUIRE( g->summon_mon( mtype_id( "mon_zombie" ), g->u.pos() + tripoint( 30, 30, 0 ) ) );
+        CHECK_FALSE( guy.has_valid_plan() );
+        g->clear_zombies();
+        CHECK( guy.has_valid_plan() );
+    }
+
+    SECTION("The plan expires") {
+        calendar::turn += 10;
+        CHECK_FALSE( guy.has_valid_plan() );
+    }
+
+    SECTION("Changing the attitude invalidates the plan") {
+        guy.attitude = NPCATT_NULL;
+        CHECK_FALSE( guy.has_valid_plan() );
+    }
+
+    calendar::turn = start;
+}
@@ -1,6 +1,14 @@
 #include "catch/catch.hpp"
 
+#include "game.h"
+#include "line.h"
 #include "overmap.h"
+#include "overmapbuffer.h"
+#include "player.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
 
 TEST_CASE( "set_and_get_overmap_scents" ) {
     overmap test_overmap;
@@ -19,3 +27,106 @@ TEST_CASE( "set_and_get_overmap_scents" ) {
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).creation_turn == 50 );
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
+
+TEST_CASE( "overmap_seen_matches_line_walk" ) {
+    const tripoint ompos = g->u.global_omt_location();
+    const int dist = g->u.overmap_sight_range( g->light_level( g->u.posz() ) );
+
+    for( int x = ompos.x - dist; x <= ompos.x + dist; x++ ) {
+        for( int y = ompos.y - dist; y <= ompos.y + dist; y++ ) {
+            overmap_buffer.set_seen( x, y, ompos.z, false );
+        }
+    }
+
+    g->update_overmap_seen();
+
+    // Reference implementation: walk a separate line to each target tile.
+    for( int x = ompos.x - dist; x <= ompos.x + dist; x++ ) {
+        for( int y = ompos.y - dist; y <= ompos.y + dist; y++ ) {
+            int sight_points = dist;
+            for( const point &p : line_to( ompos.x, ompos.y, x, y, 0 ) ) {
+                if( sight_points < 0 ) {
+                    break;
+                }
+                sight_points -= int( overmap_buffer.ter( p.x, p.y, ompos.z )->get_see_cost() );
+            }
+            const bool expected = sight_points >= 0 || ( x == ompos.x && y == ompos.y );
+            INFO( "x: " << x << " y: " << y );
+            CHECK( overmap_buffer.seen( x, y, ompos.z ) == expected );
+        }
+    }
+}
+
+TEST_CASE( "overmap_generation_is_deterministic" ) {
+    const auto generate = []() {
+        srand( 1234 );
+        return std::unique_ptr<overmap>( new overmap( 73, 91 ) );
+    };
+    const auto first = generate();
+    const auto second = generate();
+
+    int differences = 0;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                if( first->get_ter( x, y, z ) != second->get_ter( x, y, z ) ) {
+                    differences++;
+                }
+            }
+        }
+    }
+    CHECK( differences == 0 );
+}
+
+TEST_CASE( "overmap_roads_connect_all_cities" ) {
+    for( const unsigned seed : { 1234u, 42u, 7u } ) {
+        srand( seed );
+        const std::unique_ptr<overmap> om( new overmap( 73, 91 ) );
+        INFO( "seed " << seed );
+        REQUIRE_FALSE( om->cities.empty() );
+
+        // Specials placed after the roads may cover some of them (e.g. craters),
+        // so anything that isn't wilderness counts as connected.
+        const auto is_road = [&om]( const int x, const int y ) {
+            const oter_id &oter = om->get_ter( x, y, 0 );
+            return !is_ot_type( "field", oter ) && !is_ot_type( "forest", oter ) &&
+                   !is_ot_type( "river", oter );
+        };
+        // Flood fill the road network from the first city
+        std::vector<bool> reached( OMAPX * OMAPY, false );
+        std::vector<point> pending = { point( om->cities.front().x, om->cities.front().y ) };
+        reached[pending.front().y * OMAPX + pending.front().x] = true;
+        while( !pending.empty() ) {
+            const point p = pending.back();
+            pending.pop_back();
+            for( const point &d : { point( 1, 0 ), point( -1, 0 ), point( 0, 1 ), point( 0, -1 ) } ) {
+                const point n( p.x + d.x, p.y + d.y );
+                if( n.x >= 0 && n.x < OMAPX && n.y >= 0 && n.y < OMAPY &&
+                    !reached[n.y * OMAPX + n.x] && is_road( n.x, n.y ) ) {
+                    reached[n.y * OMAPX + n.x] = true;
+                    pending.push_back( n );
+                }
+            }
+        }
+
+        for( const city &c : om->cities ) {
+            INFO( "city at " << c.x << "," << c.y );
+            CHECK( reached[c.y * OMAPX + c.x] );
+        }
+        for( const city &c : om->roads_out ) {
+            INFO( "road out at " << c.x << "," << c.y );
+            CHECK( reached[c.y * OMAPX + c.x] );
+        }
+    }
+}
+
+TEST_CASE( "overmap_generation_performance", "[.]" ) {
+    const auto start = std::chrono::steady_clock::now();
+    for( int i = 0; i < 5; i++ ) {
+        srand( 1000 + i );
+        overmap om( 20 + i, 40 );
+    }
+    const auto end = std::chrono::steady_clock::now();
+    WARN( "5 overmaps generated in " <<
+          std::chrono::duration_cast<std::chrono::milliseconds>( end - start ).count() << " ms" );
+}
@@ -0,0 +1,164 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "overmapbuffer.h"
+#include "player.h"
+#include "scratch_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+TEST_CASE( "scratch_vectors_use_the_arena", "[scratch]" ) {
+    scratch_arena arena( 1024 );
+    {
+        scratch_vector<int> values{ scratch_allocator<int>( arena ) };
+        for( int i = 0; i < 1000; i++ ) {
+            values.push_back( i );
+        }
+        CHECK( values[999] == 999 );
+        CHECK( arena.live() == 1 );
+        // Larger than a block, so it got its own.
+        CHECK( arena.capacity() >= 1024 + 1000 * sizeof( int ) );
+    }
+    CHECK( arena.live() == 0 );
+    CHECK( arena.allocations() > 1 );
+}
+
+TEST_CASE( "scratch_arena_reuses_freed_memory", "[scratch]" ) {
+    scratch_arena arena( 1024 );
+    void *first = arena.allocate( 100, 8 );
+    void *second = arena.allocate( 100, 8 );
+    // The latest allocation is given back right away.
+    arena.deallocate( second, 100 );
+    CHECK( arena.allocate( 100, 8 ) == second );
+    // Otherwise only once nothing is allocated anymore.
+    arena.deallocate( first, 100 );
+    void *third = arena.allocate( 100, 8 );
+    CHECK( third != first );
+    arena.deallocate( second, 100 );
+    arena.deallocate( third, 100 );
+    CHECK( arena.allocate( 100, 8 ) == first );
+    arena.deallocate( first, 100 );
+
+    void *small = arena.allocate( 1, 1 );
+    void *aligned = arena.allocate( 8, 64 );
+    CHECK( reinterpret_cast<std::uintptr_t>( aligned ) % 64 == 0 );
+    arena.deallocate( aligned, 8 );
+    arena.deallocate( small, 1 );
+    CHECK( arena.live() == 0 );
+}
+
+TEST_CASE( "scratch_arena_reset_merges_blocks", "[scratch]" ) {
+    scratch_arena arena( 256 );
+    const auto fill = [&arena]() {
+        std::vector<void *> used;
+        for( int i = 0; i < 10; i++ ) {
+            used.push_back( arena.allocate( 200, 8 ) );
+        }
+        for( void *ptr : used ) {
+            arena.deallocate( ptr, 200 );
+        }
+    };
+    fill();
+    const size_t needed = arena.capacity();
+    CHECK( needed >= 2000 );
+    arena.reset();
+    CHECK( arena.capacity() == needed );
+    // Everything fits into the merged block now.
+    fill();
+    CHECK( arena.capacity() == needed );
+    arena.reset();
+}
+
+TEST_CASE( "scratch_arena_poisons_freed_memory", "[scratch]" ) {
+    const bool old_poison = scratch_arena::poison;
+    scratch_arena::poison = true;
+    scratch_arena arena;
+    unsigned char *keep = static_cast<unsigned char *>( arena.allocate( 16, 1 ) );
+    unsigned char *freed = static_cast<unsigned char *>( arena.allocate( 16, 1 ) );
+    std::fill( freed, freed + 16, 0 );
+    arena.deallocate( freed, 16 );
+    CHECK( std::count( freed, freed + 16, scratch_arena::poison_byte ) == 16 );
+    arena.deallocate( keep, 16 );
+    scratch_arena::poison = old_poison;
+}
+
+TEST_CASE( "scratch_arena_can_be_disabled", "[scratch]" ) {
+    const bool old_enabled = scratch_arena::enabled;
+    scratch_arena arena;
+    scratch_arena::enabled = false;
+    void *heap = arena.allocate( 16, 8 );
+    CHECK( arena.allocations() == 0 );
+    scratch_arena::enabled = true;
+    void *scratch = arena.allocate( 16, 8 );
+    CHECK( arena.allocations() == 1 );
+    // Memory is returned to where it came from.
+    arena.deallocate( heap, 16 );
+    arena.deallocate( scratch, 16 );
+    CHECK( arena.live() == 0 );
+    scratch_arena::enabled = old_enabled;
+}
+
+#ifndef MEMORY_TAGGING
+// memory_usage replaces these itself when tagging allocations.
+static std::atomic<size_t> heap_allocations( 0 );
+
+void *operator new( size_t size )
+{
+    heap_allocations++;
+    void *ptr = std::malloc( size > 0 ? size : 1 );
+    if( ptr == nullptr ) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete( void *ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+TEST_CASE( "scratch_arena_heap_allocations_per_turn", "[.]" ) {
+    const tripoint pos( SEEX * int( MAPSIZE / 2 ), SEEY * int( MAPSIZE / 2 ), g->get_levz() );
+    std::vector<tripoint> spots;
+    for( int i = 0; i < 40; i++ ) {
+        spots.push_back( pos + tripoint( i % 8 - 4, i / 8 + 2, 0 ) );
+        // Corpses of monsters that revive are active items.
+        g->m.add_item( spots.back(), item::make_corpse( mtype_id( "mon_zombie" ) ) );
+    }
+    const tripoint omt = g->u.global_omt_location();
+    const auto turn = [&omt]() {
+        g->m.process_active_items();
+        g->m.build_map_cache( g->get_levz(), true );
+        for( int x = -5; x <= 5; x++ ) {
+            for( int y = -5; y <= 5; y++ ) {
+                overmap_buffer.is_safe( omt.x + x, omt.y + y, omt.z );
+            }
+        }
+        turn_arena().reset();
+    };
+    const auto allocations_per_turn = [&turn]( const bool enabled ) {
+        scratch_arena::enabled = enabled;
+        turn();
+        const size_t before = heap_allocations;
+        for( int i = 0; i < 100; i++ ) {
+            turn();
+        }
+        return ( heap_allocations - before ) / 100;
+    };
+    const size_t heap = allocations_per_turn( false );
+    const size_t scratch = allocations_per_turn( true );
+    WARN( "heap allocations per turn: " << heap << " without the arena, " << scratch << " with it" );
+    CHECK( scratch < heap );
+
+    for( const tripoint &p : spots ) {
+        g->m.i_clear( p );
+    }
+}
+#endif
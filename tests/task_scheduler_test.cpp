@@ -0,0 +1,194 @@
+#include "catch/catch.hpp"
+
+#include "task_scheduler.h"
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+/** Runs the test with the given number of workers and restores the old number afterwards. */
+class workers_scope
+{
+    public:
+        workers_scope( const unsigned count ) : previous( tasks::workers() ) {
+            tasks::set_workers( count );
+        }
+        ~workers_scope() {
+            tasks::set_workers( previous );
+        }
+    private:
+        unsigned previous;
+};
+
+const std::vector<unsigned> worker_counts = { 0, 1, 3, 8 };
+
+long fibonacci( const int n )
+{
+    if( n < 2 ) {
+        return n;
+    }
+    long a = 0;
+    long b = 0;
+    tasks::task_group group;
+    group.run( [&a, n]() {
+        a = fibonacci( n - 1 );
+    } );
+    group.run( [&b, n]() {
+        b = fibonacci( n - 2 );
+    } );
+    group.wait();
+    return a + b;
+}
+
+} // namespace
+
+TEST_CASE( "task_chunks_depend_only_on_range_and_grain", "[tasks]" ) {
+    using chunk = std::pair<size_t, size_t>;
+    CHECK( tasks::chunks( 3, 10, 3 ) == std::vector<chunk>( { { 3, 6 }, { 6, 9 }, { 9, 10 } } ) );
+    CHECK( tasks::chunks( 0, 4, 0 ) == std::vector<chunk>( { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 } } ) );
+    CHECK( tasks::chunks( 5, 5, 2 ).empty() );
+}
+
+TEST_CASE( "parallel_for_visits_each_index_once", "[tasks]" ) {
+    for( const unsigned count : worker_counts ) {
+        workers_scope scope( count );
+        std::vector<std::atomic<int>> visits( 10007 );
+        for( auto &v : visits ) {
+            v = 0;
+        }
+        tasks::parallel_for( 0, visits.size(), 64, [&visits]( const size_t b, const size_t e ) {
+            for( size_t i = b; i < e; i++ ) {
+                visits[i]++;
+            }
+        } );
+        int wrong = 0;
+        for( const auto &v : visits ) {
+            wrong += v != 1;
+        }
+        CAPTURE( count );
+        CHECK( wrong == 0 );
+    }
+}
+
+TEST_CASE( "ordered_reductions_do_not_depend_on_worker_count", "[tasks]" ) {
+    // Floating point addition is not associative, a different order would show up in the
+    // lowest bits of the sum.
+    std::minstd_rand rng( 7 );
+    std::uniform_real_distribution<double> dist( -1e6, 1e6 );
+    std::vector<double> values( 100000 );
+    for( auto &v : values ) {
+        v = dist( rng ) * dist( rng ) * 1e-3;
+    }
+    const auto sum = [&values]( const size_t b, const size_t e ) {
+        double s = 0;
+        for( size_t i = b; i < e; i++ ) {
+            s += values[i];
+        }
+        return s;
+    };
+    const auto add = []( const double a, const double b ) {
+        return a + b;
+    };
+
+    std::vector<double> sums;
+    std::vector<std::vector<int>> transformed;
+    for( const unsigned count : worker_counts ) {
+        workers_scope scope( count );
+        sums.push_back( tasks::parallel_reduce( 0, values.size(), 777, 0.0, sum, add ) );
+        transformed.push_back( tasks::parallel_transform<int>( 0, values.size(), 100,
+        [&values]( const size_t i ) {
+            return static_cast<int>( values[i] ) % 1000;
+        } ) );
+    }
+    for( size_t i = 1; i < sums.size(); i++ ) {
+        CAPTURE( worker_counts[i] );
+        // Compare the bits, not just up to rounding.
+        CHECK( std::memcmp( &sums[i], &sums.front(), sizeof( double ) ) == 0 );
+        CHECK( transformed[i] == transformed.front() );
+    }
+    CHECK( transformed.front()[5] == static_cast<int>( values[5] ) % 1000 );
+}
+
+TEST_CASE( "single_worker_mode_runs_on_the_calling_thread", "[tasks]" ) {
+    workers_scope scope( 0 );
+    const auto caller = std::this_thread::get_id();
+    std::vector<int> order;
+    tasks::task_group group;
+    for( int i = 0; i < 5; i++ ) {
+        group.run( [&order, &caller, i]() {
+            CHECK( std::this_thread::get_id() == caller );
+            order.push_back( i );
+        } );
+    }
+    group.wait();
+    CHECK( order == std::vector<int>( { 0, 1, 2, 3, 4 } ) );
+}
+
+TEST_CASE( "task_groups_rethrow_the_first_started_error", "[tasks]" ) {
+    for( const unsigned count : worker_counts ) {
+        workers_scope scope( count );
+        tasks::task_group group;
+        std::atomic<int> done( 0 );
+        for( int i = 0; i < 20; i++ ) {
+            group.run( [&done, i]() {
+                done++;
+                if( i == 4 || i == 11 ) {
+                    throw std::runtime_error( std::to_string( i ) );
+                }
+            } );
+        }
+        CAPTURE( count );
+        try {
+            group.wait();
+            FAIL( "no exception" );
+        } catch( const std::runtime_error &err ) {
+            CHECK( std::string( err.what() ) == "4" );
+        }
+        // The other tasks still ran.
+        CHECK( done == 20 );
+    }
+}
+
+TEST_CASE( "task_scheduler_stress", "[tasks]" ) {
+    workers_scope scope( 6 );
+    // Nested fork/join from the tasks themselves.
+    CHECK( fibonacci( 20 ) == 6765 );
+
+    // Several threads that are not workers share the scheduler at once. Catch isn't thread
+    // safe, so they only count the wrong results.
+    std::atomic<int> rounds( 0 );
+    std::atomic<int> wrong( 0 );
+    std::vector<std::thread> outside;
+    for( int t = 0; t < 4; t++ ) {
+        outside.emplace_back( [&rounds, &wrong, t]() {
+            std::minstd_rand rng( t );
+            for( int round = 0; round < 50; round++ ) {
+                const size_t n = rng() % 2000;
+                const long sum = tasks::parallel_reduce( 0, n, 1 + rng() % 50, 0L,
+                []( const size_t b, const size_t e ) {
+                    long s = 0;
+                    for( size_t i = b; i < e; i++ ) {
+                        s += i;
+                    }
+                    return s;
+                }, []( const long a, const long b ) {
+                    return a + b;
+                } );
+                const long expected = n == 0 ? 0 : n * ( n - 1 ) / 2;
+                wrong += sum != expected;
+                rounds++;
+            }
+        } );
+    }
+    for( auto &t : outside ) {
+        t.join();
+    }
+    CHECK( rounds == 200 );
+    CHECK( wrong == 0 );
+}
@@ -81,8 +81,7 @@ void init_global_game_state( const std::vector<std::string> &mods )
     world_generator->set_active_world(test_world);
     assert( world_generator->active_world != NULL );
 
-    g->load_core_data();
-    g->load_world_modfiles( world_generator->active_world );
+    g->load_world_data( world_generator->active_world );
 
     g->u = player();
     g->u.create(PLTYPE_NOW);
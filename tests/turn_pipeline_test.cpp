@@ -0,0 +1,172 @@
+#include "catch/catch.hpp"
+
+#include "calendar.h"
+#include "game.h"
+#include "map.h"
+#include "player.h"
+#include "scent_map.h"
+#include "task_scheduler.h"
+#include "turn_pipeline.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST_CASE( "turn_pipeline_orders_conflicting_stages", "[turn]" ) {
+    turn_pipeline stages;
+    stages.add( "weather", TD_WEATHER, TD_WEATHER, []() {} );
+    stages.add( "scent", TD_TERRAIN | TD_SCENT, TD_SCENT, []() {} );
+    stages.add( "fields", TD_TERRAIN | TD_FIELDS, TD_FIELDS | TD_RNG, []() {} );
+    stages.add( "items", TD_ITEMS, TD_ITEMS | TD_RNG, []() {} );
+    stages.add( "terrain", TD_TERRAIN, TD_TERRAIN, []() {} );
+    stages.add( "weather effects", TD_WEATHER, TD_SCENT, []() {} );
+    stages.add( "rotting", TD_ITEMS, TD_SCENT, []() {} );
+
+    const auto &waves = stages.waves();
+    REQUIRE( waves.size() == 3 );
+    // Stages that only share what they read run at once.
+    CHECK( waves[0] == std::vector<size_t>( { 0, 1, 2 } ) );
+    // "items" and "fields" both use the random number generator, "terrain" changes what
+    // "scent" and "fields" read, "weather effects" needs the weather and changes the scent.
+    CHECK( waves[1] == std::vector<size_t>( { 3, 4, 5 } ) );
+    // After the items changed and after the other change of the scent.
+    CHECK( waves[2] == std::vector<size_t>( { 6 } ) );
+    CHECK( stages.name( 6 ) == "rotting" );
+}
+
+TEST_CASE( "turn_pipeline_runs_independent_stages_concurrently", "[turn]" ) {
+    const bool old_parallel = turn_pipeline::parallel;
+    turn_pipeline::parallel = true;
+    // There may be no workers on a single core.
+    const unsigned old_workers = tasks::workers();
+    tasks::set_workers( std::max( old_workers, 1u ) );
+
+    std::atomic<int> started( 0 );
+    std::atomic<bool> overlapped( false );
+    const auto stage = [&started, &overlapped]() {
+        started++;
+        // Wait for the other stage, but don't hang if it never starts.
+        const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds( 5 );
+        while( started < 2 && std::chrono::steady_clock::now() < give_up ) {
+            std::this_thread::yield();
+        }
+        if( started == 2 ) {
+            overlapped = true;
+        }
+    };
+    turn_pipeline stages;
+    stages.add( "scent", TD_SCENT, TD_SCENT, stage );
+    stages.add( "weather", TD_WEATHER, TD_WEATHER, stage );
+    stages.run();
+    CHECK( overlapped );
+
+    turn_pipeline::parallel = old_parallel;
+    tasks::set_workers( old_workers );
+}
+
+/**
+ * Random stages over a few values, each value stands for one kind of turn data. The result
+ * depends on the order of every write, so running conflicting stages out of order changes it.
+ */
+static std::vector<unsigned> run_random_stages( unsigned seed, bool parallel )
+{
+    constexpr size_t kinds = 6;
+    std::minstd_rand generator( seed );
+    std::array<std::atomic<unsigned>, kinds> data;
+    for( size_t i = 0; i < kinds; i++ ) {
+        data[i] = i;
+    }
+
+    turn_pipeline stages;
+    for( unsigned s = 0; s < 12; s++ ) {
+        const unsigned reads = generator() % ( 1 << kinds );
+        const unsigned writes = generator() % ( 1 << kinds ) & generator() % ( 1 << kinds );
+        stages.add( std::to_string( s ), reads, writes, [&data, reads, writes, s]() {
+            unsigned input = s;
+            for( size_t i = 0; i < kinds; i++ ) {
+                if( reads & ( 1 << i ) ) {
+                    input = input * 31 + data[i];
+                }
+                // Gives other stages a chance to run in between.
+                std::this_thread::yield();
+            }
+            for( size_t i = 0; i < kinds; i++ ) {
+                if( writes & ( 1 << i ) ) {
+                    data[i] = data[i] * 17 + input;
+                }
+            }
+        } );
+    }
+
+    const bool old_parallel = turn_pipeline::parallel;
+    turn_pipeline::parallel = parallel;
+    stages.run();
+    turn_pipeline::parallel = old_parallel;
+
+    return std::vector<unsigned>( data.begin(), data.end() );
+}
+
+TEST_CASE( "turn_pipeline_results_do_not_depend_on_threads", "[turn]" ) {
+    for( unsigned seed = 1; seed <= 200; seed++ ) {
+        INFO( "seed " << seed );
+        CHECK( run_random_stages( seed, true ) == run_random_stages( seed, false ) );
+    }
+}
+
+/**
+ * The state of the world the parallel stages touch. Fields, items and other things left
+ * by earlier tests keep changing from one run to the next, so the random number generator
+ * and everything they affect can't be compared.
+ */
+static std::string world_checksum()
+{
+    std::ostringstream out;
+    out << g->scent.serialize();
+    const auto &floor_cache = g->m.get_cache_ref( g->get_levz() ).floor_cache;
+    for( const auto &column : floor_cache ) {
+        for( const bool floor : column ) {
+            out << floor;
+        }
+    }
+    out << g->num_zombies();
+    return out.str();
+}
+
+TEST_CASE( "world_turns_are_identical_with_parallel_stages", "[turn]" ) {
+    g->clear_zombies();
+    // The scent only spreads around the player, who is always in the middle of the map.
+    const tripoint old_pos = g->u.pos();
+    const tripoint pos( SEEX * int( MAPSIZE / 2 ) + 5, SEEY * int( MAPSIZE / 2 ) + 5, 0 );
+    g->u.setpos( pos );
+    for( int i = 0; i < 8; i++ ) {
+        g->scent.set( pos + tripoint( i * 3 - 12, i % 3 * 4 - 4, 0 ), 500 + i * 100 );
+    }
+    const std::string start_scent = g->scent.serialize();
+    const calendar start_turn = calendar::turn;
+
+    std::array<std::string, 2> results;
+    for( const bool parallel : { false, true } ) {
+        turn_pipeline::parallel = parallel;
+        g->scent.deserialize( start_scent );
+        calendar::turn = start_turn;
+        for( int turn = 0; turn < 10; turn++ ) {
+            calendar::turn.increment();
+            g->scent.set( pos, 1000 );
+            g->m.set_floor_cache_dirty( g->get_levz() );
+            g->process_world_turn();
+        }
+        results[parallel] = world_checksum();
+    }
+    turn_pipeline::parallel = true;
+    calendar::turn = start_turn;
+    g->u.setpos( old_pos );
+
+    CHECK( results[0] == results[1] );
+    // The scent did spread.
+    CHECK( results[0].substr( 0, start_scent.size() ) != start_scent );
+}
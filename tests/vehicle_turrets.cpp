@@ -1,8 +1,10 @@
 #include "catch/catch.hpp"
 
+#include "fake_shooter.h"
 #include "game.h"
 #include "itype.h"
 #include "map.h"
+#include "npc.h"
 #include "vehicle.h"
 #include "veh_type.h"
 #include "player.h"
@@ -55,3 +57,55 @@ TEST_CASE( "vehicle_turret", "[vehicle] [gun] [magazine]" ) {
         }
     }
 }
+
+TEST_CASE( "fake_shooters_are_reused_and_reset", "[gun]" ) {
+    const skill_id rifle( "rifle" );
+    const skill_id gun( "gun" );
+    const efftype_id on_roof( "on_roof" );
+
+    shooter_profile turret;
+    turret.name = "The turret";
+    turret.pos = g->u.pos() + tripoint( 5, 0, 0 );
+    turret.per = 12;
+    turret.skills = { { rifle, 8 } };
+    turret.friendly = true;
+
+    npc *first = nullptr;
+    {
+        fake_shooter shooter( turret );
+        first = &*shooter;
+        CHECK( shooter->name == "The turret" );
+        CHECK( shooter->pos() == turret.pos );
+        CHECK( shooter->per_cur == 12 );
+        CHECK( shooter->get_skill_level( rifle ) == 8 );
+        CHECK( shooter->get_skill_level( gun ) == 0 );
+        CHECK( shooter->attitude == NPCATT_FOLLOW );
+
+        // What firing a gun may leave behind
+        shooter->weapon = item( "m4a1" );
+        shooter->i_add( item( "UPS_off" ) );
+        shooter->add_effect( on_roof, 1 );
+        shooter->practice( gun, 1000 );
+        shooter->recoil = 100;
+
+        // Shots that cause more shots get their own shooter
+        fake_shooter nested( turret );
+        CHECK( &*nested != first );
+    }
+
+    shooter_profile monster_gun;
+    monster_gun.name = "The robot";
+    monster_gun.base_skill = 2;
+    fake_shooter again( monster_gun );
+    REQUIRE( &*again == first );
+    CHECK( again->name == "The robot" );
+    CHECK( again->weapon.is_null() );
+    CHECK( again->inv.size() == 0 );
+    CHECK_FALSE( again->has_effect( on_roof ) );
+    CHECK( again->get_skill_level( rifle ) == 2 );
+    CHECK( again->get_skill_level( gun ) == 2 );
+    CHECK( again->get_skill_level( gun ).exercise( true ) == 0 );
+    CHECK( again->recoil == 0 );
+    CHECK( again->per_cur == 8 );
+    CHECK( again->attitude == NPCATT_KILL );
+}